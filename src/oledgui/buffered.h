@@ -0,0 +1,135 @@
+/****************************************************************************
+ *                                                                          *
+ *  Author : lukasz.iwaszkiewicz@gmail.com                                  *
+ *  ~~~~~~~~                                                                *
+ *  License : see COPYING file for details.                                 *
+ *  ~~~~~~~~~                                                               *
+ ****************************************************************************/
+
+#pragma once
+#include "charGrid.h"
+#include "oledgui.h"
+
+namespace og {
+
+/**
+ * Shadow buffer adapter. Widgets draw into the back grid, and on refresh only the cells
+ * that differ from what is already on the screen (front grid) are forwarded to the real
+ * backend. Consecutive changed cells of the same style are sent in one print call.
+ * Backend can be any display (NcursesDisplay, zephyr::cfb::Display etc.).
+ */
+template <Dimension widthV, Dimension heightV, typename Backend>
+class BufferedDisplay : public AbstractDisplay<BufferedDisplay<widthV, heightV, Backend>, widthV, heightV> {
+public:
+        using Base = AbstractDisplay<BufferedDisplay<widthV, heightV, Backend>, widthV, heightV>;
+        using Base::cursor;
+        using Base::width, Base::height;
+
+        explicit BufferedDisplay (Backend &b) : backend{b} {}
+
+        void print (std::span<const char> const &str) final { back.write (cursor (), str, style_); }
+
+        void clear () final
+        {
+                back.clear ();
+                cursor () = {0, 0};
+        }
+
+        void textStyle (style::Text stl) final { style_ = stl; }
+        void refresh () final;
+
+        /// Forces the next refresh to repaint the whole screen (for instance when the backend was cleared externally).
+        void invalidate () { fullRepaint = true; }
+
+        /// Number of cells forwarded to the backend during the last refresh.
+        std::size_t cellsSent () const { return cellsSent_; }
+
+        /// Number of cells forwarded to the backend since construction.
+        std::size_t totalCellsSent () const { return totalCellsSent_; }
+
+        detail::CharGrid<widthV, heightV> const &grid () const { return back; }
+
+private:
+        void send (Coordinate x, Coordinate y, std::span<detail::Cell const> run);
+
+        Backend &backend;
+        detail::CharGrid<widthV, heightV> front{};
+        detail::CharGrid<widthV, heightV> back{};
+        style::Text style_{};
+        style::Text backendStyle{};
+        bool fullRepaint{true};
+        std::size_t cellsSent_{};
+        std::size_t totalCellsSent_{};
+};
+
+/*--------------------------------------------------------------------------*/
+
+template <Dimension widthV, Dimension heightV, typename Backend> void BufferedDisplay<widthV, heightV, Backend>::refresh ()
+{
+        cellsSent_ = 0;
+
+        if (fullRepaint) {
+                // After clearing the backend, what is on the screen is known exactly : blank cells.
+                backend.clear ();
+                backend.textStyle (style::Text::regular);
+                backendStyle = style::Text::regular;
+                front.clear ();
+                fullRepaint = false;
+        }
+
+        for (Coordinate y = 0; y < heightV; ++y) {
+                auto frontRow = front.row (y);
+                auto backRow = back.row (y);
+                Coordinate x = 0;
+
+                while (x < widthV) {
+                        if (frontRow[x] == backRow[x]) {
+                                ++x;
+                                continue;
+                        }
+
+                        // Extend the run as long as cells differ and share the same style.
+                        Coordinate end = x + 1;
+
+                        while (end < widthV && frontRow[end] != backRow[end] && backRow[end].style == backRow[x].style) {
+                                ++end;
+                        }
+
+                        send (x, y, backRow.subspan (x, end - x));
+                        std::copy (std::next (backRow.begin (), x), std::next (backRow.begin (), end), std::next (frontRow.begin (), x));
+                        x = end;
+                }
+        }
+
+        if (backendStyle != style::Text::regular) {
+                backend.textStyle (style::Text::regular);
+                backendStyle = style::Text::regular;
+        }
+
+        totalCellsSent_ += cellsSent_;
+        backend.refresh ();
+}
+
+/*--------------------------------------------------------------------------*/
+
+template <Dimension widthV, Dimension heightV, typename Backend>
+void BufferedDisplay<widthV, heightV, Backend>::send (Coordinate x, Coordinate y, std::span<detail::Cell const> run)
+{
+        std::array<char, widthV * std::tuple_size_v<decltype (detail::Cell::glyph)>> tmp;
+        auto iter = tmp.begin ();
+
+        for (auto const &cell : run) {
+                iter = std::copy_n (cell.glyph.cbegin (), cell.size (), iter);
+        }
+
+        if (run.front ().style != backendStyle) {
+                backend.textStyle (run.front ().style);
+                backendStyle = run.front ().style;
+        }
+
+        backend.cursor () = {x, y};
+        backend.print (std::span<const char> (tmp.begin (), iter));
+        cellsSent_ += run.size ();
+}
+
+} // namespace og
@@ -0,0 +1,180 @@
+/****************************************************************************
+ *                                                                          *
+ *  Author : lukasz.iwaszkiewicz@gmail.com                                  *
+ *  ~~~~~~~~                                                                *
+ *  License : see COPYING file for details.                                 *
+ *  ~~~~~~~~~                                                               *
+ ****************************************************************************/
+
+#pragma once
+#include "oledgui.h"
+
+namespace og::detail {
+
+/**
+ * Single character cell. Holds one UTF-8 encoded character (up to 4 bytes, zero padded)
+ * and the style it was printed with.
+ */
+struct Cell {
+        std::array<char, 4> glyph{' '};
+        style::Text style{};
+
+        bool operator== (Cell const &) const = default;
+
+        /// Number of meaningful bytes in the glyph.
+        std::size_t size () const { return std::distance (glyph.cbegin (), std::find (glyph.cbegin (), glyph.cend (), '\0')); }
+};
+
+/**
+ * Fixed size grid of character cells (row major). No I/O, no dynamic allocation.
+ */
+template <Dimension widthV, Dimension heightV> class CharGrid {
+public:
+        using Cells = std::array<Cell, widthV * heightV>;
+
+        void clear () { cells_.fill (Cell{}); }
+
+        /// Prints str at pos. Characters falling outside the grid are dropped.
+        void write (Point const &pos, std::span<const char> const &str, style::Text stl);
+
+        Cell &at (Coordinate x, Coordinate y) { return cells_.at (y * widthV + x); }
+        Cell const &at (Coordinate x, Coordinate y) const { return cells_.at (y * widthV + x); }
+
+        std::span<Cell, widthV> row (Coordinate y) { return std::span<Cell, widthV>{std::next (cells_.begin (), y * widthV), widthV}; }
+        std::span<Cell const, widthV> row (Coordinate y) const
+        {
+                return std::span<Cell const, widthV>{std::next (cells_.cbegin (), y * widthV), widthV};
+        }
+
+        Cells &cells () { return cells_; }
+        Cells const &cells () const { return cells_; }
+
+        bool operator== (CharGrid const &) const = default;
+
+private:
+        Cells cells_{};
+};
+
+/*--------------------------------------------------------------------------*/
+
+template <Dimension widthV, Dimension heightV>
+void CharGrid<widthV, heightV>::write (Point const &pos, std::span<const char> const &str, style::Text stl)
+{
+        if (pos.y () < 0 || pos.y () >= heightV) {
+                return;
+        }
+
+        Coordinate x = pos.x () - 1; // Advanced on the first lead byte.
+        std::size_t byte{};
+        Cell *cell{};
+
+        for (char chr : str) {
+                if (chr == '\0') {
+                        break;
+                }
+
+                // UTF-8 continuation bytes (10xxxxxx) belong to the previous character.
+                bool continuation = (static_cast<uint8_t> (chr) & 0xc0U) == 0x80U;
+
+                if (!continuation) {
+                        if (++x >= Coordinate (widthV)) {
+                                break;
+                        }
+
+                        cell = (x >= 0) ? &at (x, pos.y ()) : nullptr;
+                        byte = 0;
+
+                        if (cell != nullptr) {
+                                *cell = Cell{{}, stl};
+                        }
+                }
+
+                if (cell != nullptr && byte < cell->glyph.size ()) {
+                        cell->glyph.at (byte++) = chr;
+                }
+        }
+}
+
+} // namespace og::detail
+
+namespace og {
+
+/**
+ * Headless display which renders into a detail::CharGrid. No I/O at all, so it is suitable
+ * for benchmarking the library itself (without the cost of a terminal) and for comparing
+ * rendered screens in tests.
+ */
+template <Dimension widthV, Dimension heightV> class CharGridDisplay : public AbstractDisplay<CharGridDisplay<widthV, heightV>, widthV, heightV> {
+public:
+        using Base = AbstractDisplay<CharGridDisplay<widthV, heightV>, widthV, heightV>;
+        using Base::cursor;
+        using Grid = detail::CharGrid<widthV, heightV>;
+
+        void print (std::span<const char> const &str) final { grid_.write (cursor (), str, style_); }
+
+        void clear () final
+        {
+                grid_.clear ();
+                cursor () = {0, 0};
+        }
+
+        void textStyle (style::Text stl) final { style_ = stl; }
+        void refresh () final { ++refreshes_; }
+
+        Grid const &grid () const { return grid_; }
+
+        /// FNV-1a hash of all the cells (glyphs and styles).
+        uint64_t hash () const;
+
+        /// Copies row y (glyphs only) into out and returns the part that was written.
+        std::string_view row (Coordinate y, std::span<char> out) const;
+
+        std::size_t refreshes () const { return refreshes_; }
+
+private:
+        Grid grid_{};
+        style::Text style_{};
+        std::size_t refreshes_{};
+};
+
+/*--------------------------------------------------------------------------*/
+
+template <Dimension widthV, Dimension heightV> uint64_t CharGridDisplay<widthV, heightV>::hash () const
+{
+        uint64_t hsh = 0xcbf29ce484222325ULL;
+
+        auto add = [&hsh] (uint8_t byte) {
+                hsh ^= byte;
+                hsh *= 0x100000001b3ULL;
+        };
+
+        for (detail::Cell const &cell : grid_.cells ()) {
+                for (char chr : cell.glyph) {
+                        add (static_cast<uint8_t> (chr));
+                }
+
+                add (static_cast<uint8_t> (cell.style));
+        }
+
+        return hsh;
+}
+
+/*--------------------------------------------------------------------------*/
+
+template <Dimension widthV, Dimension heightV>
+std::string_view CharGridDisplay<widthV, heightV>::row (Coordinate y, std::span<char> out) const
+{
+        std::size_t len{};
+
+        for (detail::Cell const &cell : grid_.row (y)) {
+                if (len + cell.size () > out.size ()) {
+                        break;
+                }
+
+                len = std::distance (out.begin (), std::copy_n (cell.glyph.cbegin (), cell.size (), std::next (out.begin (), len)));
+        }
+
+        return {out.data (), len};
+}
+
+} // namespace og
@@ -0,0 +1,158 @@
+/****************************************************************************
+ *                                                                          *
+ *  Author : lukasz.iwaszkiewicz@gmail.com                                  *
+ *  ~~~~~~~~                                                                *
+ *  License : see COPYING file for details.                                 *
+ *  ~~~~~~~~~                                                               *
+ ****************************************************************************/
+
+#pragma once
+#include "framebuffer.h"
+#include <mutex>
+#include <optional>
+
+namespace og {
+
+/// For DoubleBuffers used from a single thread of execution.
+struct NoLock {
+        void lock () {}
+        void unlock () {}
+};
+
+/**
+ * Double buffered transfer queue between a PageFramebuffer (the UI) and a slow bus. It is a
+ * c::pageDevice : PageFramebuffer::flush writes the changed page windows into the back buffer
+ * and commit ends the frame. A flush worker (a thread, or a DMA completion interrupt) takes
+ * the windows of the front buffer one by one with next, and buffers are swapped when the front
+ * one has been sent entirely. If the UI commits faster than the bus can go, frames are merged
+ * in the back buffer (only the newest contents is sent), so the UI never waits for the bus.
+ *
+ * Mutex protects the swap. Use std::mutex with threads, an interrupt lock with DMA, NoLock
+ * if next is called from the UI thread.
+ */
+template <Dimension widthPx, Dimension heightPx, typename Mutex = NoLock> class DoubleBuffer {
+public:
+        static constexpr Dimension pages = heightPx / 8;
+
+        /// A single page window to be sent over the bus.
+        struct Transfer {
+                Coordinate x{};
+                Coordinate page{};
+                std::span<uint8_t const> columns;
+        };
+
+        /// UI side. Stores the columns in the back buffer.
+        void write (Coordinate x, Coordinate page, std::span<uint8_t const> columns);
+
+        /// UI side. Ends the frame. Returns true if the worker is idle, and has to be woken up (see next).
+        bool commit ();
+
+        /**
+         * Worker side. Returns the next window to send. A call means the previous one has been sent. If the
+         * front buffer is done, buffers are swapped, and the first window of the next frame is returned,
+         * or nothing if no frame is waiting (the worker goes idle). Columns stay valid until the next call.
+         */
+        std::optional<Transfer> next ();
+
+        /// Sequence number of the last committed frame (starting from 1).
+        std::size_t committed () const
+        {
+                std::lock_guard lock{mutex};
+                return committed_;
+        }
+
+        /// Sequence number of the last frame sent entirely. Merged frames are completed together.
+        std::size_t completed () const
+        {
+                std::lock_guard lock{mutex};
+                return completed_;
+        }
+
+private:
+        /// Half open range of columns [begin, end). Empty if begin >= end.
+        struct Range {
+                Coordinate begin{widthPx};
+                Coordinate end{};
+        };
+
+        struct Buffer {
+                std::array<uint8_t, widthPx * pages> columns{};
+                std::array<Range, pages> ranges{};
+                std::size_t sequence{};
+        };
+
+        Buffer &front () { return buffers.at (frontIndex); }
+        Buffer &back () { return buffers.at (1 - frontIndex); }
+
+        std::array<Buffer, 2> buffers{};
+        std::size_t frontIndex{};
+        std::size_t committed_{};
+        std::size_t completed_{};
+        Coordinate sendingPage{pages}; // Page of the front buffer to be sent next. pages means done.
+        bool busy{};
+        bool pending{}; // Back buffer has a committed frame.
+        mutable Mutex mutex{};
+};
+
+/*--------------------------------------------------------------------------*/
+
+template <Dimension widthPx, Dimension heightPx, typename Mutex>
+void DoubleBuffer<widthPx, heightPx, Mutex>::write (Coordinate x, Coordinate page, std::span<uint8_t const> columns)
+{
+        std::lock_guard lock{mutex};
+        auto &buf = back ();
+        std::copy (columns.begin (), columns.end (), std::next (buf.columns.begin (), page * widthPx + x));
+        auto &range = buf.ranges.at (page);
+        range.begin = std::min (range.begin, x);
+        range.end = std::max (range.end, Coordinate (x + columns.size ()));
+}
+
+/*--------------------------------------------------------------------------*/
+
+template <Dimension widthPx, Dimension heightPx, typename Mutex> bool DoubleBuffer<widthPx, heightPx, Mutex>::commit ()
+{
+        std::lock_guard lock{mutex};
+        back ().sequence = ++committed_;
+        pending = true;
+        return !busy;
+}
+
+/*--------------------------------------------------------------------------*/
+
+template <Dimension widthPx, Dimension heightPx, typename Mutex>
+auto DoubleBuffer<widthPx, heightPx, Mutex>::next () -> std::optional<Transfer>
+{
+        std::lock_guard lock{mutex};
+
+        while (true) {
+                for (; sendingPage < pages; ++sendingPage) {
+                        auto &range = front ().ranges.at (sendingPage);
+
+                        if (range.begin < range.end) {
+                                Transfer ret{range.begin, sendingPage,
+                                             std::span<uint8_t const> (std::next (front ().columns.cbegin (), sendingPage * widthPx + range.begin),
+                                                                       std::size_t (range.end - range.begin))};
+                                range = Range{};
+                                ++sendingPage;
+                                return ret;
+                        }
+                }
+
+                if (busy) {
+                        completed_ = front ().sequence;
+                }
+
+                if (!pending) {
+                        busy = false;
+                        return {};
+                }
+
+                // Swap. The old front becomes the back, its ranges are already empty.
+                frontIndex = 1 - frontIndex;
+                sendingPage = 0;
+                pending = false;
+                busy = true;
+        }
+}
+
+} // namespace og
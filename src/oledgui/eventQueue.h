@@ -0,0 +1,81 @@
+/****************************************************************************
+ *                                                                          *
+ *  Author : lukasz.iwaszkiewicz@gmail.com                                  *
+ *  ~~~~~~~~                                                                *
+ *  License : see COPYING file for details.                                 *
+ *  ~~~~~~~~~                                                               *
+ ****************************************************************************/
+
+#pragma once
+#include "oledgui.h"
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <optional>
+
+namespace og {
+
+enum class Press : uint8_t { normal, longPress };
+
+/// A key as reported by a button driver.
+struct KeyEvent {
+        Key key{};
+        Press press{};
+        uint32_t timestamp{}; // Milliseconds, or whatever the driver's tick is (e.g. k_uptime_get_32).
+};
+
+/**
+ * Wait-free single producer single consumer ring. push is meant for an ISR (or a driver thread),
+ * pop for the UI loop. Neither locks nor blocks, so the queue is safe to use from an interrupt
+ * as long as there is only one producer and one consumer (a second ISR with a different priority
+ * would be a second producer). Capacity has to be a power of 2, and all of it is usable.
+ */
+template <typename T = KeyEvent, std::size_t capacity = 16> class EventQueue {
+public:
+        static_assert (std::has_single_bit (capacity), "EventQueue capacity has to be a power of 2");
+        static_assert (std::atomic<std::size_t>::is_always_lock_free);
+
+        /// Producer side. Returns false if the queue is full (the event is lost, and counted).
+        bool push (T const &event)
+        {
+                auto const t = tail.load (std::memory_order_relaxed);
+
+                if (t - head.load (std::memory_order_acquire) == capacity) {
+                        overruns_.fetch_add (1, std::memory_order_relaxed);
+                        return false;
+                }
+
+                slots.at (t & (capacity - 1)) = event;
+                tail.store (t + 1, std::memory_order_release);
+                return true;
+        }
+
+        /// Consumer side. Returns the oldest event, or nothing if the queue is empty.
+        std::optional<T> pop ()
+        {
+                auto const h = head.load (std::memory_order_relaxed);
+
+                if (h == tail.load (std::memory_order_acquire)) {
+                        return {};
+                }
+
+                T event = slots.at (h & (capacity - 1));
+                head.store (h + 1, std::memory_order_release);
+                return event;
+        }
+
+        /// Approximate if called while the other side is running.
+        std::size_t size () const { return tail.load (std::memory_order_acquire) - head.load (std::memory_order_acquire); }
+        bool empty () const { return size () == 0; }
+
+        /// Number of events pushed when the queue was full.
+        std::size_t overruns () const { return overruns_.load (std::memory_order_relaxed); }
+
+private:
+        std::array<T, capacity> slots{};
+        std::atomic<std::size_t> head{}; // Written by the consumer only.
+        std::atomic<std::size_t> tail{}; // Written by the producer only.
+        std::atomic<std::size_t> overruns_{};
+};
+
+} // namespace og
@@ -139,6 +139,9 @@ public:
         constexpr explicit Progress (ValueT const &cid) : valueContainer (cid) {}
         template <typename Wrapper> Visibility operator() (auto &disp, Context const &ctx) const;
 
+        /// The value differs from what was drawn the last time.
+        bool changed () const { return valueContainer != drawnValue; }
+
         Value &value () { return valueContainer; }
         Value const &value () const { return valueContainer; }
 
@@ -157,6 +160,7 @@ private:
         static auto &getSegments (int characterNum);
 
         ValueT valueContainer; // Can be int, can be int &. Or any other std::integral and its reference
+        mutable Value drawnValue{};
 };
 
 /*--------------------------------------------------------------------------*/
@@ -187,7 +191,7 @@ template <typename ValueT, Dimension widthV, typename std::remove_reference_t<Va
 template <typename Wrapper>
 Visibility Progress<ValueT, widthV, min, max, LocalStyle>::operator() (auto &disp, Context const & /* ctx */) const
 {
-
+        drawnValue = valueContainer;
         Value const barLen = std::min<Value> (valueContainer / unit, width);
         int num{};
 
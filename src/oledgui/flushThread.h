@@ -0,0 +1,90 @@
+/****************************************************************************
+ *                                                                          *
+ *  Author : lukasz.iwaszkiewicz@gmail.com                                  *
+ *  ~~~~~~~~                                                                *
+ *  License : see COPYING file for details.                                 *
+ *  ~~~~~~~~~                                                               *
+ ****************************************************************************/
+
+#pragma once
+#include "doubleBuffer.h"
+#include <condition_variable>
+#include <thread>
+
+namespace og {
+
+/**
+ * Flush worker for Linux (and other hosted systems). A c::pageDevice for the PixelDisplay : it
+ * collects the frame in a DoubleBuffer, and a thread sends it over the (blocking) Bus, so
+ * refresh returns as soon as the frame is committed. On a device, call DoubleBuffer::next
+ * from the DMA completion interrupt instead.
+ */
+template <Dimension widthPx, Dimension heightPx, c::pageDevice Bus> class FlushThread {
+public:
+        using Buffer = DoubleBuffer<widthPx, heightPx, std::mutex>;
+
+        explicit FlushThread (Bus &b) : bus{b}, worker{[this] (std::stop_token const &stop) { run (stop); }} {}
+
+        FlushThread (FlushThread const &) = delete;
+        FlushThread &operator= (FlushThread const &) = delete;
+        FlushThread (FlushThread &&) noexcept = delete;
+        FlushThread &operator= (FlushThread &&) noexcept = delete;
+        ~FlushThread () = default; // The jthread requests stop and joins.
+
+        void write (Coordinate x, Coordinate page, std::span<uint8_t const> columns) { buffer_.write (x, page, columns); }
+
+        /// Ends the frame (called by PixelDisplay::refresh). Does not wait for the bus.
+        void commit ()
+        {
+                if (buffer_.commit ()) {
+                        {
+                                std::lock_guard lock{mutex};
+                                kicked = true;
+                        }
+
+                        wakeUp.notify_one ();
+                }
+        }
+
+        /// Blocks until every frame committed so far has been sent.
+        void wait () const
+        {
+                std::unique_lock lock{mutex};
+                progress.wait (lock, [this] { return buffer_.completed () >= buffer_.committed (); });
+        }
+
+        Buffer const &buffer () const { return buffer_; }
+
+private:
+        void run (std::stop_token const &stop);
+
+        Bus &bus;
+        Buffer buffer_;
+        mutable std::mutex mutex;
+        std::condition_variable_any wakeUp;
+        mutable std::condition_variable progress;
+        bool kicked{};
+        std::jthread worker; // Last, so it starts when everything else is ready.
+};
+
+/*--------------------------------------------------------------------------*/
+
+template <Dimension widthPx, Dimension heightPx, c::pageDevice Bus> void FlushThread<widthPx, heightPx, Bus>::run (std::stop_token const &stop)
+{
+        while (true) {
+                while (auto transfer = buffer_.next ()) {
+                        bus.write (transfer->x, transfer->page, transfer->columns);
+                }
+
+                std::unique_lock lock{mutex};
+                progress.notify_all ();
+
+                if (!wakeUp.wait (lock, stop, [this] { return kicked; })) {
+                        return; // Stop requested.
+                }
+
+                kicked = false;
+        }
+}
+
+} // namespace og
@@ -0,0 +1,109 @@
+/****************************************************************************
+ *                                                                          *
+ *  Author : lukasz.iwaszkiewicz@gmail.com                                  *
+ *  ~~~~~~~~                                                                *
+ *  License : see COPYING file for details.                                 *
+ *  ~~~~~~~~~                                                               *
+ ****************************************************************************/
+
+#pragma once
+#include "oledgui.h"
+
+namespace og {
+
+namespace c {
+
+        /**
+         * Bitmap font for page oriented (SSD1306 like) framebuffers. A glyph is width columns
+         * times height / 8 pages, page after page, LSB on top.
+         */
+        template <typename F>
+        concept font = requires (char32_t chr) {
+                               requires F::height % 8 == 0;
+                               { F::glyph (chr) } -> std::convertible_to<std::span<uint8_t const, F::width * F::height / 8>>;
+                       };
+
+} // namespace c
+
+namespace font {
+
+        namespace detail {
+
+                /// The classic 5x7 font (printable ASCII, from ' ' to '~').
+                constexpr std::array<uint8_t, 95 * 5> classic5x7{
+                        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5f, 0x00, 0x00, 0x00, 0x07, 0x00, 0x07, 0x00, 0x14, 0x7f, 0x14, 0x7f, 0x14, // !"#
+                        0x24, 0x2a, 0x7f, 0x2a, 0x12, 0x23, 0x13, 0x08, 0x64, 0x62, 0x36, 0x49, 0x56, 0x20, 0x50, 0x00, 0x08, 0x07, 0x03, 0x00, // $%&'
+                        0x00, 0x1c, 0x22, 0x41, 0x00, 0x00, 0x41, 0x22, 0x1c, 0x00, 0x2a, 0x1c, 0x7f, 0x1c, 0x2a, 0x08, 0x08, 0x3e, 0x08, 0x08, // ()*+
+                        0x00, 0x80, 0x70, 0x30, 0x00, 0x08, 0x08, 0x08, 0x08, 0x08, 0x00, 0x00, 0x60, 0x60, 0x00, 0x20, 0x10, 0x08, 0x04, 0x02, // ,-./
+                        0x3e, 0x51, 0x49, 0x45, 0x3e, 0x00, 0x42, 0x7f, 0x40, 0x00, 0x72, 0x49, 0x49, 0x49, 0x46, 0x21, 0x41, 0x49, 0x4d, 0x33, // 0123
+                        0x18, 0x14, 0x12, 0x7f, 0x10, 0x27, 0x45, 0x45, 0x45, 0x39, 0x3c, 0x4a, 0x49, 0x49, 0x31, 0x41, 0x21, 0x11, 0x09, 0x07, // 4567
+                        0x36, 0x49, 0x49, 0x49, 0x36, 0x46, 0x49, 0x49, 0x29, 0x1e, 0x00, 0x00, 0x14, 0x00, 0x00, 0x00, 0x40, 0x34, 0x00, 0x00, // 89:;
+                        0x00, 0x08, 0x14, 0x22, 0x41, 0x14, 0x14, 0x14, 0x14, 0x14, 0x00, 0x41, 0x22, 0x14, 0x08, 0x02, 0x01, 0x59, 0x09, 0x06, // <=>?
+                        0x3e, 0x41, 0x5d, 0x59, 0x4e, 0x7c, 0x12, 0x11, 0x12, 0x7c, 0x7f, 0x49, 0x49, 0x49, 0x36, 0x3e, 0x41, 0x41, 0x41, 0x22, // @ABC
+                        0x7f, 0x41, 0x41, 0x41, 0x3e, 0x7f, 0x49, 0x49, 0x49, 0x41, 0x7f, 0x09, 0x09, 0x09, 0x01, 0x3e, 0x41, 0x41, 0x51, 0x73, // DEFG
+                        0x7f, 0x08, 0x08, 0x08, 0x7f, 0x00, 0x41, 0x7f, 0x41, 0x00, 0x20, 0x40, 0x41, 0x3f, 0x01, 0x7f, 0x08, 0x14, 0x22, 0x41, // HIJK
+                        0x7f, 0x40, 0x40, 0x40, 0x40, 0x7f, 0x02, 0x1c, 0x02, 0x7f, 0x7f, 0x04, 0x08, 0x10, 0x7f, 0x3e, 0x41, 0x41, 0x41, 0x3e, // LMNO
+                        0x7f, 0x09, 0x09, 0x09, 0x06, 0x3e, 0x41, 0x51, 0x21, 0x5e, 0x7f, 0x09, 0x19, 0x29, 0x46, 0x26, 0x49, 0x49, 0x49, 0x32, // PQRS
+                        0x03, 0x01, 0x7f, 0x01, 0x03, 0x3f, 0x40, 0x40, 0x40, 0x3f, 0x1f, 0x20, 0x40, 0x20, 0x1f, 0x3f, 0x40, 0x38, 0x40, 0x3f, // TUVW
+                        0x63, 0x14, 0x08, 0x14, 0x63, 0x03, 0x04, 0x78, 0x04, 0x03, 0x61, 0x59, 0x49, 0x4d, 0x43, 0x00, 0x7f, 0x41, 0x41, 0x41, // XYZ[
+                        0x02, 0x04, 0x08, 0x10, 0x20, 0x00, 0x41, 0x41, 0x41, 0x7f, 0x04, 0x02, 0x01, 0x02, 0x04, 0x40, 0x40, 0x40, 0x40, 0x40, // \]^_
+                        0x00, 0x03, 0x07, 0x08, 0x00, 0x20, 0x54, 0x54, 0x78, 0x40, 0x7f, 0x28, 0x44, 0x44, 0x38, 0x38, 0x44, 0x44, 0x44, 0x28, // `abc
+                        0x38, 0x44, 0x44, 0x28, 0x7f, 0x38, 0x54, 0x54, 0x54, 0x18, 0x00, 0x08, 0x7e, 0x09, 0x02, 0x18, 0xa4, 0xa4, 0x9c, 0x78, // defg
+                        0x7f, 0x08, 0x04, 0x04, 0x78, 0x00, 0x44, 0x7d, 0x40, 0x00, 0x20, 0x40, 0x40, 0x3d, 0x00, 0x7f, 0x10, 0x28, 0x44, 0x00, // hijk
+                        0x00, 0x41, 0x7f, 0x40, 0x00, 0x7c, 0x04, 0x78, 0x04, 0x78, 0x7c, 0x08, 0x04, 0x04, 0x78, 0x38, 0x44, 0x44, 0x44, 0x38, // lmno
+                        0xfc, 0x18, 0x24, 0x24, 0x18, 0x18, 0x24, 0x24, 0x18, 0xfc, 0x7c, 0x08, 0x04, 0x04, 0x08, 0x48, 0x54, 0x54, 0x54, 0x24, // pqrs
+                        0x04, 0x04, 0x3f, 0x44, 0x24, 0x3c, 0x40, 0x40, 0x20, 0x7c, 0x1c, 0x20, 0x40, 0x20, 0x1c, 0x3c, 0x40, 0x30, 0x40, 0x3c, // tuvw
+                        0x44, 0x28, 0x10, 0x28, 0x44, 0x4c, 0x90, 0x90, 0x90, 0x7c, 0x44, 0x64, 0x54, 0x4c, 0x44, 0x00, 0x08, 0x36, 0x41, 0x00, // xyz{
+                        0x00, 0x00, 0x77, 0x00, 0x00, 0x00, 0x41, 0x36, 0x08, 0x00, 0x02, 0x01, 0x02, 0x04, 0x02                                // |}~
+                };
+
+                /// Widens every glyph from srcWidth to dstWidth columns (empty columns on the right).
+                template <std::size_t srcWidth, std::size_t dstWidth, std::size_t size>
+                consteval auto pad (std::array<uint8_t, size> const &src)
+                {
+                        std::array<uint8_t, size / srcWidth * dstWidth> ret{};
+
+                        for (std::size_t glyph = 0; glyph < size / srcWidth; ++glyph) {
+                                for (std::size_t col = 0; col < srcWidth; ++col) {
+                                        ret.at (glyph * dstWidth + col) = src.at (glyph * srcWidth + col);
+                                }
+                        }
+
+                        return ret;
+                }
+
+        } // namespace detail
+
+        /**
+         * 5x7 glyphs in 6x8 cells (one column and one row of spacing). Printable ASCII plus
+         * ▲ and ▼. Every other character is rendered as '?'.
+         */
+        struct Classic6x8 {
+                static constexpr Dimension width = 6;
+                static constexpr Dimension height = 8;
+                static constexpr char32_t first = U' ';
+                static constexpr char32_t last = U'~';
+                static constexpr auto data = detail::pad<5, width> (detail::classic5x7);
+                static constexpr std::array<uint8_t, width> up{0x40, 0x70, 0x7c, 0x70, 0x40, 0x00};
+                static constexpr std::array<uint8_t, width> down{0x01, 0x07, 0x1f, 0x07, 0x01, 0x00};
+
+                static constexpr std::span<uint8_t const, width> glyph (char32_t chr)
+                {
+                        if (chr == U'▲') {
+                                return up;
+                        }
+
+                        if (chr == U'▼') {
+                                return down;
+                        }
+
+                        if (chr < first || chr > last) {
+                                chr = U'?';
+                        }
+
+                        return std::span<uint8_t const, width>{std::next (data.begin (), (chr - first) * width), width};
+                }
+        };
+
+} // namespace font
+} // namespace og
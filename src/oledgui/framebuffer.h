@@ -0,0 +1,219 @@
+/****************************************************************************
+ *                                                                          *
+ *  Author : lukasz.iwaszkiewicz@gmail.com                                  *
+ *  ~~~~~~~~                                                                *
+ *  License : see COPYING file for details.                                 *
+ *  ~~~~~~~~~                                                               *
+ ****************************************************************************/
+
+#pragma once
+#include "oledgui.h"
+#include <cstring>
+
+namespace og {
+
+namespace c {
+
+        /**
+         * Something that can receive a horizontal run of columns of a single page
+         * (8 pixel tall row). Zephyr display device, mock device etc.
+         */
+        template <typename D>
+        concept pageDevice = requires (D dev, Coordinate x, Coordinate page, std::span<uint8_t const> columns) {
+                                     dev.write (x, page, columns);
+                             };
+
+} // namespace c
+
+/**
+ * Monochrome framebuffer organised in 8 pixel tall pages like in the SSD1306 (one byte is a
+ * column of 8 pixels, LSB on top). Every page tracks the range of columns touched since the
+ * last flush. Because og::draw clears and repaints everything, touched does not mean changed,
+ * so a copy of what the device already shows is kept as well, and flush narrows every touched
+ * range down to the columns that actually differ. Only those windows go over the bus.
+ */
+template <Dimension widthPx, Dimension heightPx> class PageFramebuffer {
+public:
+        static_assert (heightPx % 8 == 0, "Height has to be a multiple of the page height (8 pixels).");
+        static constexpr Dimension width = widthPx;
+        static constexpr Dimension pages = heightPx / 8;
+
+        /// Fills the whole buffer with a pattern (0x00 black, 0xff white).
+        void clear (uint8_t pattern = 0x00);
+
+        /// Copies columns into a page starting at x. Every byte is XOR-ed with the mask (0xff inverts).
+        void blit (Coordinate x, Coordinate page, std::span<uint8_t const> columns, uint8_t xorMask = 0x00);
+
+        /// Inverts width columns of a page starting at x.
+        void invert (Coordinate x, Coordinate page, Dimension len);
+
+        /// Sends the changed windows to the device. Returns the number of bytes sent.
+        template <c::pageDevice Device> std::size_t flush (Device &dev);
+
+        /// Forces the next flush to send the whole buffer (device contents is unknown).
+        void invalidate () { synced = false; }
+
+        uint8_t column (Coordinate x, Coordinate page) const { return buffer.at (page * widthPx + x); }
+        std::span<uint8_t const> data () const { return buffer; }
+
+        /// Pixel (x, y) is lit.
+        bool pixel (Coordinate x, Coordinate y) const { return (column (x, y / 8) & (1U << (y % 8))) != 0; }
+
+        /// Prints the buffer as ASCII art, one line per pixel row ('#' lit, '.' dark). For tests and debugging.
+        template <typename Stream> void dump (Stream &out) const;
+
+private:
+        /// Half open range of columns [begin, end). Empty if begin >= end.
+        struct Range {
+                Coordinate begin{widthPx};
+                Coordinate end{};
+        };
+
+        void touch (Coordinate page, Coordinate begin, Coordinate end);
+
+        std::array<uint8_t, widthPx * pages> buffer{};
+        std::array<uint8_t, widthPx * pages> flushed{}; // What the device shows.
+        std::array<Range, pages> dirty{};
+        bool synced{};
+};
+
+/*--------------------------------------------------------------------------*/
+
+template <Dimension widthPx, Dimension heightPx> void PageFramebuffer<widthPx, heightPx>::touch (Coordinate page, Coordinate begin, Coordinate end)
+{
+        auto &range = dirty.at (page);
+        range.begin = std::min (range.begin, begin);
+        range.end = std::max (range.end, end);
+}
+
+/*--------------------------------------------------------------------------*/
+
+template <Dimension widthPx, Dimension heightPx> void PageFramebuffer<widthPx, heightPx>::clear (uint8_t pattern)
+{
+        buffer.fill (pattern);
+
+        for (Coordinate page = 0; page < pages; ++page) {
+                touch (page, 0, widthPx);
+        }
+}
+
+/*--------------------------------------------------------------------------*/
+
+template <Dimension widthPx, Dimension heightPx>
+void PageFramebuffer<widthPx, heightPx>::blit (Coordinate x, Coordinate page, std::span<uint8_t const> columns, uint8_t xorMask)
+{
+        if (page < 0 || page >= pages || x >= Coordinate (widthPx)) {
+                return;
+        }
+
+        // Clip on both sides.
+        auto skip = std::max<int> (0, -x);
+        auto len = std::min<int> (int (columns.size ()) - skip, widthPx - std::max<int> (x, 0));
+
+        if (len <= 0) {
+                return;
+        }
+
+        auto begin = Coordinate (std::max<int> (x, 0));
+        uint8_t *dst = std::next (buffer.data (), page * widthPx + begin);
+        uint8_t const *src = std::next (columns.data (), skip);
+        int i{};
+
+        // 8 columns at a time, the mask replicated over a 64 bit word.
+        uint64_t const wideMask = 0x0101010101010101ULL * xorMask;
+
+        for (; i + 8 <= len; i += 8) {
+                uint64_t word{};
+                std::memcpy (&word, std::next (src, i), sizeof (word));
+                word ^= wideMask;
+                std::memcpy (std::next (dst, i), &word, sizeof (word));
+        }
+
+        for (; i < len; ++i) {
+                dst[i] = src[i] ^ xorMask;
+        }
+
+        touch (page, begin, Coordinate (begin + len));
+}
+
+/*--------------------------------------------------------------------------*/
+
+template <Dimension widthPx, Dimension heightPx> template <typename Stream> void PageFramebuffer<widthPx, heightPx>::dump (Stream &out) const
+{
+        for (Coordinate y = 0; y < Coordinate (heightPx); ++y) {
+                for (Coordinate x = 0; x < Coordinate (widthPx); ++x) {
+                        out << (pixel (x, y) ? '#' : '.');
+                }
+
+                out << '\n';
+        }
+}
+
+/*--------------------------------------------------------------------------*/
+
+template <Dimension widthPx, Dimension heightPx> void PageFramebuffer<widthPx, heightPx>::invert (Coordinate x, Coordinate page, Dimension len)
+{
+        if (page < 0 || page >= pages) {
+                return;
+        }
+
+        auto begin = std::clamp<int> (x, 0, widthPx);
+        auto end = std::clamp<int> (x + len, 0, widthPx);
+        auto row = std::next (buffer.begin (), page * widthPx);
+        std::for_each (std::next (row, begin), std::next (row, end), [] (uint8_t &col) { col = ~col; });
+
+        if (begin < end) {
+                touch (page, Coordinate (begin), Coordinate (end));
+        }
+}
+
+/*--------------------------------------------------------------------------*/
+
+template <Dimension widthPx, Dimension heightPx>
+template <c::pageDevice Device>
+std::size_t PageFramebuffer<widthPx, heightPx>::flush (Device &dev)
+{
+        std::size_t bytes{};
+
+        for (Coordinate page = 0; page < pages; ++page) {
+                auto range = dirty.at (page);
+                dirty.at (page) = Range{};
+
+                if (!synced) {
+                        range = {0, widthPx};
+                }
+
+                if (range.begin >= range.end) {
+                        continue;
+                }
+
+                auto row = std::next (buffer.cbegin (), page * widthPx);
+                auto flushedRow = std::next (flushed.begin (), page * widthPx);
+                auto first = range.begin;
+                auto last = range.end;
+
+                if (synced) {
+                        // Narrow the touched range down to the columns which really differ.
+                        while (first < last && row[first] == flushedRow[first]) {
+                                ++first;
+                        }
+
+                        while (last > first && row[last - 1] == flushedRow[last - 1]) {
+                                --last;
+                        }
+
+                        if (first == last) {
+                                continue;
+                        }
+                }
+
+                dev.write (first, page, std::span<uint8_t const> (std::next (row, first), std::next (row, last)));
+                std::copy (std::next (row, first), std::next (row, last), std::next (flushedRow, first));
+                bytes += last - first;
+        }
+
+        synced = true;
+        return bytes;
+}
+
+} // namespace og
@@ -8,13 +8,19 @@
 
 #pragma once
 #include "oledgui.h"
+#include <chrono>
 #include <ncurses.h>
+#include <optional>
 #include <type_traits>
 
 namespace og {
 
 /**
  * Ncurses backend.
+ * Strings are written directly with their length (no temporary copies, no format strings),
+ * the current attribute is cached, so textStyle does not touch the window if nothing changes,
+ * and the screen is updated with wnoutrefresh + doupdate. If you have more than one display,
+ * draw them with og::draw<true, false>, call noutrefresh on each, and then ::doupdate once.
  */
 template <Dimension widthV, Dimension heightV> class NcursesDisplay : public AbstractDisplay<NcursesDisplay<widthV, heightV>, widthV, heightV> {
 public:
@@ -34,38 +40,41 @@ public:
                 endwin ();
         }
 
-        void print (std::span<const char> const &str) override
+        void print (std::span<const char> const &str) final
         {
-                // This is to ensure mvwprintw does not print the whole string.
-                std::string tmp{str.begin (), str.end ()};
-                mvwprintw (win, cursor ().y (), cursor ().x (), tmp.data ()); // TODO why not c_str?
+                mvwaddnstr (win, cursor ().y (), cursor ().x (), str.data (), int (str.size ()));
         }
 
-        void clear () override
+        void clear () final
         {
-                wclear (win);
+                // werase instead of wclear, so the next refresh does not repaint the whole terminal.
+                werase (win);
                 cursor ().x () = 0;
                 cursor ().y () = 0;
         }
 
-        void textStyle (style::Text clr) override
+        void textStyle (style::Text clr) final
         {
-                if (clr == style::Text::highlighted) {
-                        wattron (win, COLOR_PAIR (2));
-                }
-                else {
-                        wattron (win, COLOR_PAIR (1));
+                if (clr == style_) {
+                        return;
                 }
+
+                style_ = clr;
+                wattrset (win, COLOR_PAIR ((clr == style::Text::highlighted) ? 2 : 1));
         }
 
-        void refresh () override
+        void refresh () final
         {
-                ::refresh ();
-                wrefresh (win);
+                noutrefresh ();
+                doupdate ();
         }
 
+        /// Copies the window to the virtual screen without updating the terminal.
+        void noutrefresh () { wnoutrefresh (win); }
+
 private:
         WINDOW *win{};
+        style::Text style_{};
 };
 
 /****************************************************************************/
@@ -84,6 +93,8 @@ template <Dimension widthV, Dimension heightV> NcursesDisplay<widthV, heightV>::
         keypad (stdscr, true);
         win = newwin (height (), width (), 0, 0);
         wbkgd (win, COLOR_PAIR (1));
+        wattrset (win, COLOR_PAIR (1));
+        ::refresh (); // Once, so getch's implicit refresh of stdscr does not overwrite our window.
         refresh ();
 }
 
@@ -115,4 +126,16 @@ inline og::Key getKey (int chr)
 
 inline og::Key getKey () { return getKey (getch ()); }
 
+/// Waits for a key at most delay (forever if there is no delay). For Scheduler::step.
+template <typename Duration> std::optional<og::Key> waitKey (std::optional<Duration> delay)
+{
+        ::timeout (delay ? int (std::chrono::ceil<std::chrono::milliseconds> (*delay).count ()) : -1);
+
+        if (int chr = getch (); chr != ERR) {
+                return getKey (chr);
+        }
+
+        return {};
+}
+
 } // namespace og
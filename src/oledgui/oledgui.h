@@ -9,6 +9,7 @@
 #pragma once
 #include <algorithm>
 #include <array>
+#include <bit>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
@@ -38,7 +39,7 @@ using Selection = uint8_t;
 using LineOffset = int;
 
 namespace style {
-        enum class Text { regular, highlighted };
+        enum class Text : uint8_t { regular, highlighted };
         enum class Focus { disabled, enabled };
         enum class Editable { no, yes };
 
@@ -173,6 +174,22 @@ struct Dimensions {
         Dimension height{};
 };
 
+/**
+ * Rectangular area of the display (in characters).
+ */
+struct Rect {
+        Point origin{};
+        Dimensions dimensions{};
+};
+
+/**
+ * Part of the display text is printed into. detail::print drops (clips) everything outside of it.
+ */
+struct Viewport {
+        Rect area{};
+        std::size_t clipped{}; // Number of characters clipped so far.
+};
+
 /**
  * Runtime context for all the recursive loops.
  */
@@ -181,6 +198,7 @@ struct Context {
         Dimensions const dimensions{};
         Focus currentFocus{};
         Coordinate currentScroll{};
+        std::span<Rect const> occluders{}; // Areas covered by the windows above (see og::compose).
 };
 
 enum class Key { unknown, incrementFocus, decrementFocus, select };
@@ -343,12 +361,142 @@ struct IDisplay {
 
         virtual Point &cursor () = 0;
         virtual Point const &cursor () const = 0;
+
+        virtual Viewport &viewport () = 0;
+        virtual Viewport const &viewport () const = 0;
 };
 
 namespace detail {
-        template <c::string String> void print (IDisplay &disp, String const &str)
+
+        /// Not a UTF-8 continuation byte.
+        constexpr bool isLeadByte (char chr) { return (uint8_t (chr) & 0xc0U) != 0x80U; }
+
+        /**
+         * Display width of a UTF-8 string (up to the first '\0'), i.e. the number of character cells it
+         * occupies. Every code point takes one cell. Constant evaluation counts byte by byte, at runtime
+         * 8 bytes are examined at once.
+         */
+        constexpr std::size_t displayWidth (std::string_view str)
+        {
+                str = str.substr (0, str.find ('\0'));
+
+                if (std::is_constant_evaluated ()) {
+                        return std::count_if (str.cbegin (), str.cend (), isLeadByte);
+                }
+
+                std::size_t continuationBytes{};
+                std::size_t i{};
+
+                for (; i + sizeof (uint64_t) <= str.size (); i += sizeof (uint64_t)) {
+                        uint64_t word{};
+                        std::memcpy (&word, std::next (str.data (), i), sizeof (word));
+                        // Bit 7 set and bit 6 cleared (shifted into the bit 7 position) means 10xxxxxx.
+                        continuationBytes += std::popcount (word & ~(word << 1U) & 0x8080808080808080ULL);
+                }
+
+                for (; i < str.size (); ++i) {
+                        continuationBytes += int (!isLeadByte (str[i]));
+                }
+
+                return str.size () - continuationBytes;
+        }
+
+        template <c::string String> constexpr std::size_t displayWidth (String const &str)
         {
-                disp.print (std::span<const char> (str.begin (), str.end ()));
+                return displayWidth (std::string_view (str.begin (), str.end ()));
+        }
+
+        /// Display width of a string literal, always computed at compile time.
+        template <std::size_t N> consteval Dimension displayWidth (char const (&str)[N])
+        {
+                return Dimension (displayWidth (std::string_view (str, N - 1)));
+        }
+
+        static_assert (displayWidth ("▲ ▼") == 3);
+        static_assert (displayWidth ("abc") == 3);
+
+        /**
+         * Display width of a widget label. A std::string_view is measured again only if it is changed to
+         * point to another string. Other string types (like a std::string bound with std::ref) can be
+         * modified in place, so they are measured every time.
+         */
+        template <typename String> class DisplayWidthCache {
+        public:
+                constexpr explicit DisplayWidthCache (String const &str)
+                {
+                        if constexpr (cacheable) {
+                                update (str);
+                        }
+                }
+
+                constexpr Dimension operator() (String const &str) const
+                {
+                        if constexpr (cacheable) {
+                                if (str.data () != entry.data || str.size () != entry.size) {
+                                        update (str);
+                                }
+
+                                return entry.width;
+                        }
+                        else {
+                                return Dimension (displayWidth (str));
+                        }
+                }
+
+        private:
+                static constexpr bool cacheable = std::is_same_v<std::remove_cvref_t<String>, std::string_view>;
+
+                struct Entry {
+                        char const *data{};
+                        std::size_t size{};
+                        Dimension width{};
+                };
+
+                constexpr void update (String const &str) const { entry = {str.data (), str.size (), Dimension (displayWidth (str))}; }
+
+                [[no_unique_address]] mutable std::conditional_t<cacheable, Entry, Empty> entry{};
+        };
+
+        /**
+         * Prints str (up to the first '\0') at the cursor, clipped to the viewport of the display. Characters
+         * outside of it are never sent to the backend, only counted in Viewport::clipped. The cursor is
+         * left intact.
+         */
+        template <c::string String> void print (auto &disp, String const &str)
+        {
+                auto const end = std::find (str.begin (), str.end (), '\0');
+                auto &viewport = disp.viewport ();
+                Rect const &area = viewport.area;
+                Point const pos = disp.cursor ();
+
+                if (pos.y () < area.origin.y () || pos.y () >= area.origin.y () + area.dimensions.height) {
+                        viewport.clipped += std::count_if (str.begin (), end, isLeadByte);
+                        return;
+                }
+
+                auto nextCharacter = [&end] (auto iter) { return std::find_if (std::next (iter), end, isLeadByte); };
+                auto first = str.begin ();
+                Coordinate x = pos.x ();
+
+                for (; first != end && x < area.origin.x (); first = nextCharacter (first), ++x) {
+                        ++viewport.clipped;
+                }
+
+                auto last = first;
+                Coordinate const right = Coordinate (area.origin.x () + area.dimensions.width);
+
+                for (Coordinate lastX = x; last != end && lastX < right; last = nextCharacter (last), ++lastX) {
+                }
+
+                viewport.clipped += std::count_if (last, end, isLeadByte);
+
+                if (first == last) {
+                        return;
+                }
+
+                disp.cursor ().x () = x;
+                disp.print (std::span<const char> (first, last));
+                disp.cursor () = pos;
         }
 
 } // namespace detail
@@ -374,8 +522,15 @@ public:
         Point &cursor () final { return cursor_; }
         Point const &cursor () const final { return cursor_; }
 
+        Viewport &viewport () final { return viewport_; }
+        Viewport const &viewport () const final { return viewport_; }
+
+        /// Number of characters clipped (not sent to the backend) so far.
+        std::size_t clippedCharacters () const { return viewport_.clipped; }
+
 private:
         Point cursor_{};
+        Viewport viewport_{{{0, 0}, {widthV, heightV}}};
 };
 
 struct EmptyDisplay : public AbstractDisplay<EmptyDisplay, 0, 0> {
@@ -415,6 +570,73 @@ namespace detail {
         static_assert (heightsOverlap (1, 1U, 0, 2U));
         static_assert (!heightsOverlap (2, 1U, 0, 2U));
 
+        inline bool overlap (Rect const &a, Rect const &b)
+        {
+                return heightsOverlap (a.origin.x (), a.dimensions.width, b.origin.x (), b.dimensions.width)
+                        && heightsOverlap (a.origin.y (), a.dimensions.height, b.origin.y (), b.dimensions.height);
+        }
+
+        /// Common part of a and b (empty if they do not overlap).
+        inline Rect intersection (Rect const &a, Rect const &b)
+        {
+                auto left = std::max (a.origin.x (), b.origin.x ());
+                auto top = std::max (a.origin.y (), b.origin.y ());
+                auto right = std::min (a.origin.x () + a.dimensions.width, b.origin.x () + b.dimensions.width);
+                auto bottom = std::min (a.origin.y () + a.dimensions.height, b.origin.y () + b.dimensions.height);
+                return {{left, top}, {Dimension (std::max (right - left, 0)), Dimension (std::max (bottom - top, 0))}};
+        }
+
+        /// First column at or after pos.x () which is not covered by any of the areas (in the pos.y () row).
+        inline Coordinate skipCovered (std::span<Rect const> areas, Point pos)
+        {
+                for (bool moved = true; moved;) {
+                        moved = false;
+
+                        for (auto const &area : areas) {
+                                if (overlap (area, {pos, {1, 1}})) {
+                                        pos.x () = Coordinate (area.origin.x () + area.dimensions.width);
+                                        moved = true;
+                                }
+                        }
+                }
+
+                return pos.x ();
+        }
+
+        /// First column at or after pos.x () which is covered by any of the areas, or limit if none is.
+        inline Coordinate skipUncovered (std::span<Rect const> areas, Point pos, Coordinate limit)
+        {
+                for (auto const &area : areas) {
+                        if (overlap (area, {pos, {Dimension (std::max (limit - pos.x (), 0)), 1}})) {
+                                limit = std::max (area.origin.x (), pos.x ());
+                        }
+                }
+
+                return limit;
+        }
+
+        /// Fills the area with spaces, except the parts covered by the occluders. Moves the cursor.
+        void clearArea (auto &disp, Rect const &area, std::span<Rect const> occluders)
+        {
+                constexpr std::string_view spaces{"                "};
+                Coordinate const right = Coordinate (area.origin.x () + area.dimensions.width);
+                Coordinate const bottom = Coordinate (area.origin.y () + area.dimensions.height);
+                disp.textStyle (style::Text::regular);
+
+                for (Coordinate y = area.origin.y (); y < bottom; ++y) {
+                        for (Coordinate x = skipCovered (occluders, {area.origin.x (), y}); x < right; x = skipCovered (occluders, {x, y})) {
+                                Coordinate const end = skipUncovered (occluders, {x, y}, right);
+
+                                while (x < end) {
+                                        auto len = std::min<std::size_t> (end - x, spaces.size ());
+                                        disp.cursor () = {x, y};
+                                        print (disp, spaces.substr (0, len));
+                                        x = Coordinate (x + len);
+                                }
+                        }
+                }
+        }
+
 } // namespace detail
 
 /****************************************************************************/
@@ -461,7 +683,10 @@ public:
         constexpr Check (Callback clb, ChkT const &chk, String const &lbl) : label_{lbl}, checked_{chk}, callback{std::move (clb)} {}
 
         template <typename Wrapper> Visibility operator() (auto &disp, Context const &ctx) const;
-        template <typename Wrapper> void input (auto & /* d */, Context const & /* ctx */, Key key);
+        template <typename Wrapper> bool input (auto & /* d */, Context const & /* ctx */, Key key);
+
+        /// The value differs from what was drawn the last time.
+        bool changed () const { return static_cast<bool> (checked_) != drawnChecked; }
 
         bool &checked () { return checked_; }
         bool const &checked () const { return checked_; }
@@ -471,7 +696,9 @@ public:
 
 private:
         String label_;
+        detail::DisplayWidthCache<std::remove_reference_t<String>> labelWidth{label_};
         ChkT checked_{};
+        mutable bool drawnChecked{};
         Callback callback;
 };
 
@@ -490,6 +717,8 @@ Visibility Check<Callback, ChkT, String, LocalStyle>::operator() (auto &disp, Co
                 }
         }
 
+        drawnChecked = static_cast<bool> (checked_);
+
         if (checked_) {
                 detail::print (disp, style::get<style::check, LocalStyle, style::getter::Checked> ("x"sv));
         }
@@ -507,7 +736,7 @@ Visibility Check<Callback, ChkT, String, LocalStyle>::operator() (auto &disp, Co
                 }
         }
 
-        disp.cursor () += {Coordinate (label_.size ()), 0};
+        disp.cursor () += {Coordinate (labelWidth (label_)), 0};
         return Visibility::visible;
 }
 
@@ -516,7 +745,7 @@ Visibility Check<Callback, ChkT, String, LocalStyle>::operator() (auto &disp, Co
 template <typename Callback, typename ChkT, typename String, typename LocalStyle>
         requires c::string<std::remove_reference_t<String>>
 template <typename Wrapper>
-void Check<Callback, ChkT, String, LocalStyle>::input (auto & /* d */, Context const & /* ctx */, Key key)
+bool Check<Callback, ChkT, String, LocalStyle>::input (auto & /* d */, Context const & /* ctx */, Key key)
 {
         static constexpr style::Editable editable = style::get<style::check, LocalStyle, style::getter::Editable> (style::Editable::yes);
 
@@ -525,8 +754,11 @@ void Check<Callback, ChkT, String, LocalStyle>::input (auto & /* d */, Context c
                         bool tmp = !static_cast<bool> (checked_);
                         checked_ = tmp;
                         callback (tmp);
+                        return true;
                 }
         }
+
+        return false;
 }
 
 /*--------------------------------------------------------------------------*/
@@ -595,7 +827,7 @@ public:
         Visibility operator() (auto &disp, Context const &ctx, ExtValueT const &value = {}) const;
 
         template <typename Wrapper, typename Callback, typename ExtValueT>
-        void input (auto &disp, Context const &ctx, Key key, Callback &clb, ExtValueT &value);
+        bool input (auto &disp, Context const &ctx, Key key, Callback &clb, ExtValueT &value);
 
         // Value &id () { return id_; }
         Value const &id () const { return id_; }
@@ -606,6 +838,7 @@ public:
 private:
         Value id_;
         String label_;
+        detail::DisplayWidthCache<std::remove_reference_t<String>> labelWidth{label_};
 };
 
 /*--------------------------------------------------------------------------*/
@@ -642,7 +875,7 @@ Visibility Radio<String, ValueT, LocalStyle, styleTag>::operator() (auto &disp,
                 }
         }
 
-        disp.cursor () += {Coordinate (label_.size ()), 0};
+        disp.cursor () += {Coordinate (labelWidth (label_)), 0};
         return Visibility::visible;
 }
 
@@ -651,14 +884,17 @@ Visibility Radio<String, ValueT, LocalStyle, styleTag>::operator() (auto &disp,
 template <typename String, std::regular ValueT, typename LocalStyle, style::Tag styleTag>
         requires c::string<std::remove_reference_t<String>>
 template <typename Wrapper, typename Callback, typename ExtValueT>
-void Radio<String, ValueT, LocalStyle, styleTag>::input (auto & /* disp */, Context const & /* ctx */, Key key, Callback &clb, ExtValueT &value)
+bool Radio<String, ValueT, LocalStyle, styleTag>::input (auto & /* disp */, Context const & /* ctx */, Key key, Callback &clb, ExtValueT &value)
 {
         if constexpr (focus == style::Focus::enabled && editable == style::Editable::yes) {
                 if (key == Key::select) {
                         value = id ();
                         clb (id ());
+                        return true;
                 }
         }
+
+        return false;
 }
 
 /*--------------------------------------------------------------------------*/
@@ -818,7 +1054,7 @@ public:
         template <typename /* Wrapper */> Visibility operator() (auto &disp, Context const & /* ctx */) const
         {
                 detail::print (disp, label_);
-                disp.cursor () += {Coordinate (label_.size ()), 0};
+                disp.cursor () += {Coordinate (labelWidth (label_)), 0};
                 return Visibility::visible;
         }
 
@@ -827,6 +1063,7 @@ public:
 
 private:
         String label_;
+        detail::DisplayWidthCache<std::remove_reference_t<String>> labelWidth{label_};
 };
 
 template <typename String> auto label (String &&str) { return Label<std::unwrap_ref_decay_t<String>> (std::forward<String> (str)); }
@@ -861,6 +1098,7 @@ public:
 
 private:
         String label_;
+        detail::DisplayWidthCache<std::remove_reference_t<String>> labelWidth{label_};
         Callback callback;
 };
 
@@ -876,7 +1114,7 @@ Visibility Button<String, Callback>::operator() (auto &disp, Context const &ctx)
         }
 
         detail::print (disp, label_);
-        disp.cursor () += {Coordinate (label_.size ()), 0};
+        disp.cursor () += {Coordinate (labelWidth (label_)), 0};
 
         if (ctx.currentFocus == Wrapper::getFocusIndex ()) {
                 disp.textStyle (style::Text::regular);
@@ -916,9 +1154,13 @@ public:
         String &label () { return label_; }
         String const &label () const { return label_; }
 
+        /// Display width of the label.
+        Dimension width () const { return labelWidth (label_); }
+
 private:
         Value value_;
         String label_;
+        detail::DisplayWidthCache<std::remove_reference_t<String>> labelWidth{label_};
 };
 
 template <std::regular Value, c::string String> auto option (Value &&val, String &&label)
@@ -994,7 +1236,10 @@ public:
         }
 
         template <typename Wrapper> Visibility operator() (auto &disp, Context const &ctx) const;
-        template <typename Wrapper> void input (auto &disp, Context const &ctx, Key key);
+        template <typename Wrapper> bool input (auto &disp, Context const &ctx, Key key);
+
+        /// The value differs from what was drawn the last time (index_ is updated while drawing).
+        bool changed () const { return options.toIndex (static_cast<Value> (valueContainer)) != index_; }
 
         ValueContainer &value () { return valueContainer; }
         ValueContainer const &value () const { return valueContainer; }
@@ -1022,8 +1267,8 @@ Visibility Combo<Callback, ValueContainer, LocalStyle, OptionCollection>::operat
         }
 
         index_ = options.toIndex (static_cast<Value> (valueContainer));
-        auto &label = options.getOptionByIndex (index_).label ();
-        detail::print (disp, label);
+        auto const &option = options.getOptionByIndex (index_);
+        detail::print (disp, option.label ());
 
         if constexpr (focus == style::Focus::enabled) {
                 if (ctx.currentFocus == Wrapper::getFocusIndex ()) {
@@ -1031,7 +1276,7 @@ Visibility Combo<Callback, ValueContainer, LocalStyle, OptionCollection>::operat
                 }
         }
 
-        disp.cursor () += {Coordinate (label.size ()), 0};
+        disp.cursor () += {Coordinate (option.width ()), 0};
         return Visibility::visible;
 }
 
@@ -1040,7 +1285,7 @@ Visibility Combo<Callback, ValueContainer, LocalStyle, OptionCollection>::operat
 template <typename Callback, typename ValueContainer, typename LocalStyle, typename OptionCollection>
         requires std::invocable<Callback, typename OptionCollection::Value>
 template <typename Wrapper>
-void Combo<Callback, ValueContainer, LocalStyle, OptionCollection>::input (auto & /* disp */, Context const &ctx, Key key)
+bool Combo<Callback, ValueContainer, LocalStyle, OptionCollection>::input (auto & /* disp */, Context const &ctx, Key key)
 {
         if constexpr (focus == style::Focus::enabled && editable == style::Editable::yes) {
                 if (ctx.currentFocus == Wrapper::getFocusIndex () && key == Key::select) {
@@ -1049,8 +1294,11 @@ void Combo<Callback, ValueContainer, LocalStyle, OptionCollection>::input (auto
                         Value val = options.getOptionByIndex (index_).value ();
                         valueContainer = val;
                         callback (val);
+                        return true;
                 }
         }
+
+        return false;
 }
 
 /*--------------------------------------------------------------------------*/
@@ -1170,7 +1418,10 @@ public:
         constexpr explicit Number (Callback clb, ValueT const &cid) : valueContainer (cid), callback{std::move (clb)} {}
 
         template <typename Wrapper> Visibility operator() (auto &disp, Context const &ctx) const;
-        template <typename Wrapper> void input (auto &disp, Context const &ctx, Key key);
+        template <typename Wrapper> bool input (auto &disp, Context const &ctx, Key key);
+
+        /// The value differs from what was drawn the last time.
+        bool changed () const { return static_cast<Value> (valueContainer) != drawnValue; }
 
         Value &value () { return valueContainer; }
         Value const &value () const { return valueContainer; }
@@ -1179,6 +1430,7 @@ private:
         ValueT valueContainer; // Can be int, can be int &. Or any other std::integral and its reference
         using Buffer = std::array<char, detail::IntStrLen<Value>::value>;
         mutable Buffer buffer{}; // Big enough to store all the digits + '\0'
+        mutable Value drawnValue{};
         Callback callback;
 };
 
@@ -1197,6 +1449,7 @@ Visibility Number<Callback, ValueT, min, max, inc, LocalStyle>::operator() (auto
         }
 
         typename Buffer::size_type digits{};
+        drawnValue = static_cast<Value> (valueContainer);
 
         if constexpr (std::is_integral_v<Value>) {
                 digits = detail::itoa (static_cast<Value> (valueContainer), buffer);
@@ -1222,7 +1475,7 @@ Visibility Number<Callback, ValueT, min, max, inc, LocalStyle>::operator() (auto
 template <typename Callback, typename ValueT, auto min, auto max, auto inc, typename LocalStyle>
         requires c::number<Callback, ValueT, min, max, inc>
 template <typename Wrapper>
-void Number<Callback, ValueT, min, max, inc, LocalStyle>::input (auto & /* disp */, Context const &ctx, Key key)
+bool Number<Callback, ValueT, min, max, inc, LocalStyle>::input (auto & /* disp */, Context const &ctx, Key key)
 {
         constexpr auto editable = style::get<style::number, LocalStyle, style::getter::Editable> (style::Editable::yes);
 
@@ -1237,8 +1490,11 @@ void Number<Callback, ValueT, min, max, inc, LocalStyle>::input (auto & /* disp
 
                         valueContainer = tmp;
                         callback (tmp);
+                        return true;
                 }
         }
+
+        return false;
 }
 
 /*--------------------------------------------------------------------------*/
@@ -1440,9 +1696,24 @@ public:
         Callback &callback () { return callback_; }
         Callback const &callback () const { return callback_; }
 
+        /// Draws nothing by itself, only remembers the value the radios are drawn with.
+        template <typename /* Wrapper */> Visibility operator() (auto & /* disp */, Context const & /* ctx */) const
+        {
+                drawnValue = currentValue ();
+                return Visibility::nonDrawable;
+        }
+
+        /// The value differs from what was drawn the last time.
+        bool changed () const { return !(currentValue () == drawnValue); }
+
 private:
+        // Value of the radios. ValueContainer can be a reference or some other type convertible to it.
+        using Value = typename std::unwrap_ref_decay_t<std::tuple_element_t<0, WidgetTuple>>::Value;
+        Value currentValue () const { return value_; }
+
         WidgetTuple widgets_;
         ValueContainer value_; // T, T&
+        mutable Value drawnValue{};
         Callback callback_;
 };
 
@@ -1527,7 +1798,7 @@ public:
         using Child = std::remove_reference_t<std::unwrap_ref_decay_t<ChildT>>;
         explicit Window (ChildT wgt) : child_{std::move (wgt)} {} // ChildT can be a widget (like Label) or reference_wrapper <Label>
 
-        template <typename Wrapper> Visibility operator() (auto &disp, Context & /* ctx */) const;
+        template <typename Wrapper> Visibility operator() (auto &disp, Context &ctx) const;
 
         ChildT &child () { return child_; }
         ChildT const &child () const { return child_; }
@@ -1549,7 +1820,7 @@ private:
 
 template <Coordinate ox, Coordinate oy, Dimension widthV, Dimension heightV, typename LocalStyle, typename ChildT>
 template <typename Wrapper>
-Visibility Window<ox, oy, widthV, heightV, LocalStyle, ChildT>::operator() (auto &disp, Context & /* ctx */) const
+Visibility Window<ox, oy, widthV, heightV, LocalStyle, ChildT>::operator() (auto &disp, Context &ctx) const
 {
         using namespace std::string_view_literals;
         disp.cursor () = {ox, oy};
@@ -1582,6 +1853,7 @@ Visibility Window<ox, oy, widthV, heightV, LocalStyle, ChildT>::operator() (auto
                 disp.cursor () = {ox + FrameHelper::offset, oy + FrameHelper::offset};
         }
 
+        disp.viewport ().area = detail::intersection (disp.viewport ().area, {ctx.origin, ctx.dimensions}); // Children stay inside the frame.
         return Visibility::visible;
 }
 
@@ -1656,6 +1928,10 @@ namespace detail {
                                         return Visibility::outside;
                                 }
 
+                                if (occluded (disp, ctx)) {
+                                        return Visibility::visible;
+                                }
+
                                 return widget.template operator()<Widget> (disp, *ctx);
                         }
 
@@ -1665,6 +1941,10 @@ namespace detail {
                                         return Visibility::outside;
                                 }
 
+                                if (occluded (disp, ctx)) {
+                                        return Visibility::visible;
+                                }
+
                                 /*
                                  * Passing arg means copy-initialization, but there is none from say MyType to int,
                                  * so I introduced an intermediate variable here.
@@ -1673,28 +1953,72 @@ namespace detail {
                                 return widget.template operator()<Widget> (disp, *ctx, tmp);
                         }
 
-                        void input (auto &disp, Context const &ctx, Key key)
+                        /// Returns true if the widget state might have changed.
+                        bool input (auto &disp, Context const &ctx, Key key)
                         {
                                 if (ctx.currentFocus == getFocusIndex ()) {
                                         if constexpr (requires { widget.template input<Widget> (disp, ctx, key); }) {
-                                                widget.template input<Widget> (disp, ctx, key);
+                                                return callInput ([&] { return widget.template input<Widget> (disp, ctx, key); });
                                         }
                                 }
+
+                                return false;
                         }
 
                         template <typename Callback, typename ValueT>
-                        void input (auto &disp, Context const &ctx, Key key, Callback &clb, ValueT &value)
+                        bool input (auto &disp, Context const &ctx, Key key, Callback &clb, ValueT &value)
                         {
                                 if (ctx.currentFocus == getFocusIndex ()) {
                                         if constexpr (requires { widget.template input<Widget> (disp, ctx, key, clb, value); }) {
-                                                widget.template input<Widget> (disp, ctx, key, clb, value);
+                                                return callInput ([&] { return widget.template input<Widget> (disp, ctx, key, clb, value); });
                                         }
                                 }
+
+                                return false;
+                        }
+
+                        /// Visible, and its value differs from what was drawn the last time.
+                        bool changed (Context const *ctx) const
+                        {
+                                if constexpr (requires { widget.changed (); }) {
+                                        return detail::heightsOverlap (getY (), getHeight (), ctx->currentScroll, ctx->dimensions.height)
+                                                && widget.changed ();
+                                }
+
+                                return false;
                         }
 
                         void scrollToFocus (Context *ctx) const;
 
                 private:
+                        /**
+                         * Single line widget entirely covered by the windows above (see og::compose). The cursor is
+                         * moved as if it was drawn. Widgets without a static width are assumed to span to the right
+                         * edge of the window.
+                         */
+                        bool occluded (auto &disp, Context const *ctx) const
+                        {
+                                if constexpr (getHeight () != 1) {
+                                        return false;
+                                }
+                                else {
+                                        if (ctx->occluders.empty ()) {
+                                                return false;
+                                        }
+
+                                        auto &cursor = disp.cursor ();
+                                        auto const end = (getWidth () > 0) ? Coordinate (cursor.x () + getWidth ())
+                                                                           : Coordinate (ctx->origin.x () + ctx->dimensions.width);
+
+                                        if (detail::skipCovered (ctx->occluders, cursor) < end) {
+                                                return false;
+                                        }
+
+                                        cursor.x () = end;
+                                        return true;
+                                }
+                        }
+
                         template <typename X> friend void log (X const &, int);
                         T widget; // Wrapped widget. 2 options X or X&
                 };
@@ -1739,6 +2063,21 @@ namespace detail {
                         }
                 }
 
+                /**
+                 * Calls a layer 1 input method. Widgets may return bool telling if their state has changed.
+                 * Those returning void (like Button, whose callback can do anything) are assumed to change it.
+                 */
+                template <typename Fun> bool callInput (Fun const &fun)
+                {
+                        if constexpr (std::is_void_v<std::invoke_result_t<Fun>>) {
+                                fun ();
+                                return true;
+                        }
+                        else {
+                                return fun ();
+                        }
+                }
+
                 /**
                  * Base for widgets in the augment:: namespace that can contain other widgets.
                  */
@@ -1807,19 +2146,21 @@ namespace detail {
                                 return Visibility::visible;
                         }
 
-                        void input (auto &disp, Context &ctx, Key key)
+                        bool input (auto &disp, Context &ctx, Key key)
                         {
-                                auto lbd = [&disp, &ctx, key, concrete = static_cast<ConcreteClass *> (this)] (auto &itself, auto &child,
-                                                                                                               auto &...children) {
+                                bool changed{};
+
+                                auto lbd = [&disp, &ctx, key, &changed, concrete = static_cast<ConcreteClass *> (this)] (
+                                                   auto &itself, auto &child, auto &...children) {
                                         if constexpr (requires {
                                                               concrete->widget.callback ();
                                                               concrete->widget.value ();
                                                       }) {
 
-                                                child.input (disp, ctx, key, concrete->widget.callback (), concrete->widget.value ());
+                                                changed |= child.input (disp, ctx, key, concrete->widget.callback (), concrete->widget.value ());
                                         }
                                         else {
-                                                child.input (disp, ctx, key);
+                                                changed |= child.input (disp, ctx, key);
                                         }
 
                                         if constexpr (sizeof...(children) > 0) {
@@ -1834,6 +2175,23 @@ namespace detail {
                                                 }
                                         },
                                         static_cast<ConcreteClass *> (this)->children);
+
+                                return changed;
+                        }
+
+                        /// Something (visible) has changed since the last draw.
+                        bool changed (Context const *ctx) const
+                        {
+                                auto concrete = static_cast<ConcreteClass const *> (this);
+
+                                if constexpr (requires { concrete->widget.changed (); }) {
+                                        if (concrete->widget.changed ()) {
+                                                return true;
+                                        }
+                                }
+
+                                return std::apply ([ctx] (auto const &...children) { return (children.changed (ctx) || ...); },
+                                                   concrete->children);
                         }
 
                         void scrollToFocus (Context *ctx) const
@@ -1906,20 +2264,34 @@ namespace detail {
                  * Interface for dynamic polypomphism (see docs).
                  */
                 struct IWindow {
+                        using DisplayType = IDisplay;
                         virtual ~IWindow () = default;
 
                         virtual Visibility operator() (IDisplay &disp) const = 0;
                         virtual void input (IDisplay &disp, Key key) = 0;
+                        virtual void input (IDisplay &disp, std::span<Key const> keys) = 0;
                         virtual void incrementFocus (IDisplay &disp) const = 0;
                         virtual void decrementFocus (IDisplay &disp) const = 0;
+                        virtual bool isDirty () const = 0;
+                        virtual void invalidate () = 0;
                 };
 
+                /// Windows bound to a concrete display type have no virtual interface.
+                struct NoWindowInterface {};
+
+                template <typename Display>
+                using WindowInterface = std::conditional_t<std::is_same_v<Display, IDisplay>, IWindow, NoWindowInterface>;
+
                 /**
-                 * Window
+                 * Window. If Display is IDisplay (the default), it implements IWindow, and every display
+                 * call goes through the IDisplay vtable. Otherwise the whole draw and input path is bound
+                 * to the concrete Display type at compile time and can be inlined.
                  */
-                template <typename T, typename Child> class Window : public IWindow, public ContainerWidget<Window<T, Child>, NoDecoration> {
+                template <typename T, typename Child, typename Display = IDisplay>
+                class Window : public WindowInterface<Display>, public ContainerWidget<Window<T, Child, Display>, NoDecoration> {
                 public:
                         using Wrapped = std::remove_reference_t<T>;
+                        using DisplayType = Display;
                         constexpr explicit Window (T const &t, Child c) : widget{t}, children{std::move (c)} {}
 
                         static constexpr Dimension getWidth () { return Wrapped::width; }
@@ -1927,12 +2299,33 @@ namespace detail {
                         static constexpr Coordinate getX () { return Wrapped::x; }
                         static constexpr Coordinate getY () { return Wrapped::y; }
 
-                        Visibility operator() (IDisplay &disp) const override { return BaseClass::operator() (disp, &context); }
+                        // Virtual (overriding IWindow methods) only if Display is IDisplay.
+                        /// Everything is clipped to the window area (and to its interior, if it has a frame).
+                        Visibility operator() (Display &disp) const
+                        {
+                                dirty = false;
+                                auto &viewportArea = disp.viewport ().area;
+                                Rect const previous = viewportArea;
+                                viewportArea = detail::intersection (previous, area ());
+                                auto ret = BaseClass::operator() (disp, &context);
+                                viewportArea = previous;
+                                return ret;
+                        }
 
-                        void input (IDisplay &disp, Key key) override { BaseClass::input (disp, context, key); }
+                        void input (Display &disp, Key key) { dirty |= BaseClass::input (disp, context, key); }
 
-                        void incrementFocus (IDisplay & /* disp */) const override
+                        /**
+                         * A burst of keys. Focus moves are summed up, other keys are passed to the focused widget
+                         * in order (with the focus they would have had), and scroll is computed once at the end.
+                         * The scroll may differ from the one after the same keys passed one by one, because the
+                         * intermediate focus positions are not scrolled to.
+                         */
+                        void input (Display &disp, std::span<Key const> keys);
+
+                        void incrementFocus (Display & /* disp */) const
                         {
+                                auto const prev = context;
+
                                 if (context.currentFocus < Wrapped::focusableWidgetCount - 1) {
                                         ++context.currentFocus;
                                 }
@@ -1941,10 +2334,13 @@ namespace detail {
                                 }
 
                                 scrollToFocus (&context);
+                                dirty |= prev.currentFocus != context.currentFocus || prev.currentScroll != context.currentScroll;
                         }
 
-                        void decrementFocus (IDisplay & /* disp */) const override
+                        void decrementFocus (Display & /* disp */) const
                         {
+                                auto const prev = context;
+
                                 if (context.currentFocus > 0) {
                                         --context.currentFocus;
                                 }
@@ -1953,11 +2349,43 @@ namespace detail {
                                 }
 
                                 scrollToFocus (&context);
+                                dirty |= prev.currentFocus != context.currentFocus || prev.currentScroll != context.currentScroll;
+                        }
+
+                        /**
+                         * Has to be redrawn. True after input which changed something (focus, scroll, a value),
+                         * or if a value of a visible Check, Combo, Number, Progress or Group is different from the
+                         * one drawn the last time (even if it was changed outside via std::ref). Other changes
+                         * like contents of a Text buffer are not tracked, call invalidate in such case.
+                         */
+                        bool isDirty () const { return dirty || BaseClass::changed (&context); }
+
+                        /// Forces the next drawIfDirty to draw.
+                        void invalidate () { dirty = true; }
+
+                        /// The area of the display the window occupies.
+                        static Rect area () { return {{Wrapped::x, Wrapped::y}, {Wrapped::width, Wrapped::height}}; }
+
+                        /**
+                         * Draws the window under the areas covered by the windows above (see og::compose). Only the
+                         * uncovered part of its own area is cleared, and single line widgets hidden entirely are skipped.
+                         */
+                        Visibility compose (Display &disp, std::span<Rect const> above) const
+                        {
+                                if constexpr (!Wrapped::frame) { // The frame fills the whole area anyway.
+                                        detail::clearArea (disp, area (), above);
+                                }
+
+                                context.occluders = above;
+                                auto ret = (*this) (disp);
+                                context.occluders = {};
+                                return ret;
                         }
 
                 private:
                         mutable Context context{/* nullptr, */ {Wrapped::x + FrameHelper::offset, Wrapped::y + FrameHelper::offset},
                                                 {Wrapped::width - FrameHelper::cut, Wrapped::height - FrameHelper::cut}};
+                        mutable bool dirty{true};
 
                         template <typename X> friend void log (X const &, int);
                         template <typename CC, typename D> friend class ContainerWidget;
@@ -1967,28 +2395,76 @@ namespace detail {
                         friend ContainerWidget<Window, NoDecoration>;
                         using FrameHelper = typename Wrapped::FrameHelper;
 
-                        using BaseClass = ContainerWidget<Window<T, Child>, NoDecoration>;
-                        using BaseClass::scrollToFocus, BaseClass::input, BaseClass::operator();
+                        using BaseClass = ContainerWidget<Window<T, Child, Display>, NoDecoration>;
+                        using BaseClass::scrollToFocus, BaseClass::input, BaseClass::operator(), BaseClass::changed;
                 };
 
+                template <typename T, typename Child, typename Display>
+                void Window<T, Child, Display>::input (Display &disp, std::span<Key const> keys)
+                {
+                        constexpr int count = Wrapped::focusableWidgetCount;
+                        auto const prev = context;
+                        int focus = context.currentFocus;
+                        auto wrapped = [&focus] { return Focus (((focus % count) + count) % count); };
+
+                        for (Key key : keys) {
+                                if (key == Key::incrementFocus) {
+                                        ++focus;
+                                }
+                                else if (key == Key::decrementFocus) {
+                                        --focus;
+                                }
+                                else {
+                                        context.currentFocus = wrapped ();
+                                        dirty |= BaseClass::input (disp, context, key);
+                                }
+                        }
+
+                        if constexpr (count > 0) {
+                                context.currentFocus = wrapped ();
+                        }
+
+                        scrollToFocus (&context);
+                        dirty |= prev.currentFocus != context.currentFocus || prev.currentScroll != context.currentScroll;
+                }
+
                 template <typename T> struct is_window_wrapper : public std::bool_constant<false> {};
 
-                template <typename T, typename Child> class is_window_wrapper<Window<T, Child>> : public std::bool_constant<true> {};
+                template <typename T, typename Child, typename Display>
+                class is_window_wrapper<Window<T, Child, Display>> : public std::bool_constant<true> {};
 
                 // template <typename T>
                 // concept window_wrapper = is_window_wrapper<T>::value;
 
                 template <typename T>
-                concept window_wrapper = requires (T type, EmptyDisplay &disp, Key key) {
+                concept window_wrapper = requires (T type, typename T::DisplayType &disp, Key key) {
                                                  type.incrementFocus (disp);
                                                  type.decrementFocus (disp);
                                                  type.input (disp, key);
+                                                 type.invalidate ();
+
+                                                 {
+                                                         type.isDirty ()
+                                                         } -> std::convertible_to<bool>;
 
                                                  {
                                                          type.operator() (disp)
                                                          } -> std::same_as<Visibility>;
                                          };
 
+                /// Window which knows its area, and can be drawn by og::compose.
+                template <typename T>
+                concept composable_window = window_wrapper<T>
+                        && requires (T const type, typename T::DisplayType &disp, std::span<Rect const> above) {
+                                   {
+                                           type.area ()
+                                           } -> std::same_as<Rect>;
+
+                                   {
+                                           type.compose (disp, above)
+                                           } -> std::same_as<Visibility>;
+                           };
+
                 /****************************************************************************/
 
                 /**
@@ -2095,16 +2571,20 @@ namespace detail {
 
         template <typename Parent = void, Focus f = 0, Selection r = 0, Coordinate x = 0, Coordinate y = 0> auto wrap (auto &&t);
 
+        /// Wraps a window. Display is the display type the window will be drawn on (IDisplay means any).
+        template <typename Display, Focus f = 0, Selection r = 0, Coordinate x = 0, Coordinate y = 0, typename W> auto wrapWindow (W &&t)
+        {
+                using T = std::remove_reference_t<std::unwrap_ref_decay_t<W>>;
+                return augment::Window<std::unwrap_ref_decay_t<W>, decltype (og::detail::wrap<T, f, r, x, y> (t.child ())), Display> (
+                        std::forward<W> (t), og::detail::wrap<T, f, r, x, y> (t.child ()));
+        }
+
         // Partial specialization for Windows
         template <c::window T, typename Parent, Focus f, Selection r, Coordinate x, Coordinate y>
                 requires std::same_as<Parent, void> // Means that windows are always top level
         struct Wrap<T, Parent, f, r, x, y> {
 
-                template <typename W> static auto wrap (W &&t)
-                {
-                        return augment::Window<std::unwrap_ref_decay_t<W>, decltype (og::detail::wrap<T, f, r, x, y> (t.child ()))> (
-                                std::forward<W> (t), og::detail::wrap<T, f, r, x, y> (t.child ()));
-                }
+                template <typename W> static auto wrap (W &&t) { return wrapWindow<IDisplay, f, r, x, y> (std::forward<W> (t)); }
         };
 
         /// Default values for template arguments are in the forward declaration above
@@ -2168,6 +2648,65 @@ template <bool clear = true, bool refresh = true> Visibility draw (auto &display
         return ret;
 }
 
+/**
+ * Like draw, but returns (false) without touching the display if none of the windows is dirty.
+ * If any of them is, all are drawn (because clear clears everything). See augment::Window::isDirty.
+ */
+template <bool clear = true, bool refresh = true> bool drawIfDirty (auto &display, detail::augment::window_wrapper auto const &...window)
+{
+        if (!(window.isDirty () || ...)) {
+                return false;
+        }
+
+        draw<clear, refresh> (display, window...);
+        return true;
+}
+
+/**
+ * Draws windows (back to front) without clearing the whole display. A window is drawn only if it is dirty,
+ * or if it overlaps a window drawn before it, so the cost of a change in a dialog depends on the dialog
+ * size, not the screen size. Every window clears only the part of its area which is not covered by the
+ * windows above, and widgets covered entirely are skipped. The rest of the display is never touched, so
+ * clear it once before the first frame if the windows do not cover all of it. Returns true if anything
+ * was drawn. Pass force = true to draw all the windows regardless of their dirty state.
+ */
+template <bool refresh = true, bool force = false> bool compose (auto &display, detail::augment::composable_window auto const &...window)
+{
+        constexpr auto count = sizeof...(window);
+        std::array<Rect, count> const areas{window.area ()...};
+        std::array<bool, count> redraw{(force || window.isDirty ())...};
+        bool any{};
+
+        for (std::size_t i = 0; i < count; ++i) {
+                for (std::size_t j = 0; j < i && !redraw.at (i); ++j) {
+                        redraw.at (i) = redraw.at (j) && detail::overlap (areas.at (i), areas.at (j));
+                }
+
+                any = any || redraw.at (i);
+        }
+
+        if (!any) {
+                return false;
+        }
+
+        std::size_t i{};
+        auto drawOne = [&display, &areas, &redraw, &i] (auto const &win) {
+                if (redraw.at (i)) {
+                        win.compose (display, std::span<Rect const> (areas).subspan (i + 1));
+                }
+
+                ++i;
+        };
+
+        (drawOne (window), ...);
+
+        if constexpr (refresh) {
+                display.refresh ();
+        }
+
+        return true;
+}
+
 void input (auto &display, detail::augment::window_wrapper auto &window, Key key)
 {
         switch (key) {
@@ -2185,6 +2724,23 @@ void input (auto &display, detail::augment::window_wrapper auto &window, Key key
         }
 }
 
+/**
+ * Applies a burst of keys (e.g. a held button) at once : focus moves are summed up, other keys are
+ * passed in order, and scroll is computed once at the end instead of after every key. Windows which
+ * do not support this get the keys one by one.
+ */
+void input (auto &display, detail::augment::window_wrapper auto &window, std::span<Key const> keys)
+{
+        if constexpr (requires { window.input (display, keys); }) {
+                window.input (display, keys);
+        }
+        else {
+                for (Key key : keys) {
+                        input (display, window, key);
+                }
+        }
+}
+
 /****************************************************************************/
 
 /**
@@ -2234,18 +2790,23 @@ template <typename KeyT, typename... Win> auto element (KeyT key, Win &&...win)
 /**
  * Suite of windows. Allows you to switch currently displayed window by setting a single
  * integer. Thanks to common interface class ISuite, you can easilly pass pointers to it
- * to your handlers.
+ * to your handlers. Like augment::Window, it is bound to a concrete Display type at compile
+ * time unless Display is IDisplay.
  */
-template <typename KeyT, typename WindowElementTuple> class WindowSuite : public detail::augment::IWindow, public ISuite<KeyT> {
+template <typename KeyT, typename WindowElementTuple, typename Display = IDisplay>
+class WindowSuite : public detail::augment::WindowInterface<Display>, public ISuite<KeyT> {
 public:
         using ISuite<KeyT>::current;
+        using DisplayType = Display;
 
         explicit WindowSuite (WindowElementTuple wins) : windows{std::move (wins)} {}
 
         /// Returns the status of the last one
-        Visibility operator() (IDisplay &display) const override
+        Visibility operator() (Display &display) const
         {
                 Visibility ret{};
+                drawnKey = current ();
+                dirty = false;
 
                 applyForOne ([&display, &ret] (auto const &elem) {
                         ret = std::apply ([&display] (auto const &...win) { return og::draw<false, false> (display, win...); }, elem.win ());
@@ -2254,7 +2815,7 @@ public:
                 return ret;
         }
 
-        void input (IDisplay &display, Key key) override
+        void input (Display &display, Key key)
         {
                 applyForOne ([&display, key]<typename Elm> (Elm const &elem) {
                         constexpr auto i = std::tuple_size_v<typename Elm::WinType>;
@@ -2262,27 +2823,92 @@ public:
                 });
         }
 
-        void incrementFocus (IDisplay &display) const override
+        void input (Display &display, std::span<Key const> keys)
+        {
+                applyForOne ([&display, keys]<typename Elm> (Elm const &elem) {
+                        constexpr auto i = std::tuple_size_v<typename Elm::WinType>;
+                        std::get<i - 1> (elem.win ()).input (display, keys);
+                });
+        }
+
+        void incrementFocus (Display &display) const
         {
                 applyForOne ([&display]<typename Elm> (Elm &elem) { elem.last ().incrementFocus (display); });
         }
 
-        void decrementFocus (IDisplay &display) const override
+        void decrementFocus (Display &display) const
         {
                 applyForOne ([&display]<typename Elm> (Elm &elem) { elem.last ().decrementFocus (display); });
         }
 
+        /// Current element has changed, or any of its windows is dirty.
+        bool isDirty () const
+        {
+                bool ret = dirty || drawnKey != current ();
+
+                applyForOne ([&ret] (auto const &elem) {
+                        ret = ret || std::apply ([] (auto const &...win) { return (win.isDirty () || ...); }, elem.win ());
+                });
+
+                return ret;
+        }
+
+        void invalidate () { dirty = true; }
+
+        /**
+         * Draws the current element with og::compose, so only its dirty windows (and the ones above them)
+         * are redrawn. After switching to another element the display is cleared and everything is drawn.
+         * Elements containing windows og::compose can not handle (like IWindow references) are drawn with
+         * og::draw if any of them is dirty.
+         * Returns true if anything was drawn.
+         */
+        bool compose (Display &display) const
+        {
+                bool const switched = dirty || drawnKey != current ();
+                bool ret{};
+                drawnKey = current ();
+                dirty = false;
+
+                applyForOne ([&display, &ret, switched] (auto const &elem) {
+                        std::apply (
+                                [&display, &ret, switched] (auto const &...win) {
+                                        if constexpr ((detail::augment::composable_window<std::remove_cvref_t<decltype (win)>> && ...)) {
+                                                if (switched) {
+                                                        display.clear ();
+                                                        ret = og::compose<false, true> (display, win...);
+                                                }
+                                                else {
+                                                        ret = og::compose<false> (display, win...);
+                                                }
+
+                                                return;
+                                        }
+                                        else if (!switched && !(win.isDirty () || ...)) {
+                                                return;
+                                        }
+
+                                        og::draw<true, false> (display, win...);
+                                        ret = true;
+                                },
+                                elem.win ());
+                });
+
+                return ret;
+        }
+
 private:
         template <typename Callback> void applyForOne (Callback const &clb) const;
 
         WindowElementTuple windows;
+        mutable KeyT drawnKey{};
+        mutable bool dirty{true};
 };
 
 /*--------------------------------------------------------------------------*/
 
-template <typename KeyT, typename WindowElementTuple>
+template <typename KeyT, typename WindowElementTuple, typename Display>
 template <typename Callback>
-void WindowSuite<KeyT, WindowElementTuple>::applyForOne (Callback const &clb) const
+void WindowSuite<KeyT, WindowElementTuple, Display>::applyForOne (Callback const &clb) const
 {
         auto condition = [&clb, currentKey = current ()] (auto const &elem) -> bool {
                 if (elem.key () == currentKey) {
@@ -2297,13 +2923,33 @@ void WindowSuite<KeyT, WindowElementTuple>::applyForOne (Callback const &clb) co
 }
 
 /**
- * Facotry method
+ * Facotry method. Pass a concrete Display type to get a suite bound to it (no virtual calls).
  */
-template <typename KeyT, typename... Win> auto suite (Element<KeyT, Win> &&...el)
+template <typename KeyT, typename Display = IDisplay, typename... Win> auto suite (Element<KeyT, Win> &&...el)
 {
         using Tuple = decltype (std::tuple{std::forward<Element<KeyT, Win>> (el)...});
 
-        return WindowSuite<KeyT, Tuple>{std::tuple{std::forward<Element<KeyT, Win>> (el)...}};
+        return WindowSuite<KeyT, Tuple, Display>{std::tuple{std::forward<Element<KeyT, Win>> (el)...}};
+}
+
+/// Same as og::compose above, but for a WindowSuite.
+template <bool refresh = true, typename Suite>
+        requires requires (Suite const &suite, typename Suite::DisplayType &disp) {
+                         {
+                                 suite.compose (disp)
+                                 } -> std::same_as<bool>;
+                 }
+bool compose (auto &display, Suite const &suite)
+{
+        bool ret = suite.compose (display);
+
+        if constexpr (refresh) {
+                if (ret) {
+                        display.refresh ();
+                }
+        }
+
+        return ret;
 }
 
 /****************************************************************************/
@@ -2352,4 +2998,12 @@ auto window (W &&c)
         return detail::wrap (detail::windowRaw<ox, oy, widthV, heightV, LocalStyle> (std::forward<W> (c)));
 }
 
+/// Same as above, but the window is bound to the Display type at compile time (no virtual calls).
+template <typename Display, Coordinate ox, Coordinate oy, Dimension widthV, Dimension heightV, typename LocalStyle = style::Empty,
+          typename W = void>
+auto window (W &&c)
+{
+        return detail::wrapWindow<Display> (detail::windowRaw<ox, oy, widthV, heightV, LocalStyle> (std::forward<W> (c)));
+}
+
 } // namespace og
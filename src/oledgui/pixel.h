@@ -0,0 +1,95 @@
+/****************************************************************************
+ *                                                                          *
+ *  Author : lukasz.iwaszkiewicz@gmail.com                                  *
+ *  ~~~~~~~~                                                                *
+ *  License : see COPYING file for details.                                 *
+ *  ~~~~~~~~~                                                               *
+ ****************************************************************************/
+
+#pragma once
+#include "font.h"
+#include "framebuffer.h"
+#include "oledgui.h"
+
+namespace og {
+
+/**
+ * Portable backend for monochrome, page oriented displays (SSD1306, SH1106 etc). Glyphs come
+ * from a constexpr c::font and are blitted directly into a PageFramebuffer, highlighted ones
+ * already inverted (no second inversion pass). refresh sends the changed windows to the device.
+ * Dimensions are in pixels, the character grid is derived from the font size.
+ */
+template <Dimension widthPx, Dimension heightPx, c::font Font, c::pageDevice Device>
+class PixelDisplay : public AbstractDisplay<PixelDisplay<widthPx, heightPx, Font, Device>, widthPx / Font::width, heightPx / Font::height> {
+public:
+        using Base = AbstractDisplay<PixelDisplay<widthPx, heightPx, Font, Device>, widthPx / Font::width, heightPx / Font::height>;
+        using Base::cursor;
+        using Framebuffer = PageFramebuffer<widthPx, heightPx>;
+
+        static constexpr Dimension glyphPages = Font::height / 8;
+
+        /// inverted : white background.
+        explicit PixelDisplay (Device &dev, bool inv = false) : device{dev}, inverted{inv} {}
+
+        void print (std::span<const char> const &str) final;
+
+        void clear () final
+        {
+                framebuffer_.clear (inverted ? 0xff : 0x00);
+                cursor () = {0, 0};
+        }
+
+        void textStyle (style::Text stl) final { style_ = stl; }
+        void refresh () final
+        {
+                lastFlushBytes = framebuffer_.flush (device);
+
+                if constexpr (requires { device.commit (); }) {
+                        device.commit (); // Asynchronous devices like FlushThread send the frame now.
+                }
+        }
+
+        /// How many bytes the last refresh has sent.
+        std::size_t flushedBytes () const { return lastFlushBytes; }
+
+        Framebuffer const &framebuffer () const { return framebuffer_; }
+
+private:
+        Device &device;
+        Framebuffer framebuffer_{};
+        std::size_t lastFlushBytes{};
+        style::Text style_{};
+        bool inverted{};
+};
+
+/****************************************************************************/
+
+template <Dimension widthPx, Dimension heightPx, c::font Font, c::pageDevice Device>
+void PixelDisplay<widthPx, heightPx, Font, Device>::print (std::span<const char> const &str)
+{
+        uint8_t const mask = ((style_ == style::Text::highlighted) != inverted) ? 0xff : 0x00;
+        auto x = Coordinate (cursor ().x () * Font::width);
+        auto page = Coordinate (cursor ().y () * glyphPages);
+        auto iter = str.begin ();
+
+        while (iter != str.end () && *iter != '\0' && x < Coordinate (widthPx)) {
+                // UTF-8 decoding. Malformed sequences produce garbage, but never read past the end.
+                auto lead = static_cast<uint8_t> (*iter++);
+                int continuation = (lead >= 0xf0U) ? 3 : (lead >= 0xe0U) ? 2 : (lead >= 0xc0U) ? 1 : 0;
+                char32_t chr = lead & (0x7fU >> continuation);
+
+                for (; continuation > 0 && iter != str.end (); --continuation) {
+                        chr = (chr << 6U) | (static_cast<uint8_t> (*iter++) & 0x3fU);
+                }
+
+                auto glyph = Font::glyph (chr);
+
+                for (Coordinate i = 0; i < Coordinate (glyphPages); ++i) {
+                        framebuffer_.blit (x, Coordinate (page + i), glyph.subspan (i * Font::width, Font::width), mask);
+                }
+
+                x += Font::width;
+        }
+}
+
+} // namespace og
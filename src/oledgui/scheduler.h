@@ -0,0 +1,188 @@
+/****************************************************************************
+ *                                                                          *
+ *  Author : lukasz.iwaszkiewicz@gmail.com                                  *
+ *  ~~~~~~~~                                                                *
+ *  License : see COPYING file for details.                                 *
+ *  ~~~~~~~~~                                                               *
+ ****************************************************************************/
+
+#pragma once
+#include "oledgui.h"
+#include <chrono>
+#include <optional>
+
+namespace og {
+
+/// Counters exposed by the Scheduler.
+template <typename Duration> struct SchedulerStatistics {
+        std::size_t events{};    // Keys applied with og::input.
+        std::size_t dropped{};   // Keys lost, because the queue was full.
+        std::size_t frames{};    // Frames drawn.
+        std::size_t coalesced{}; // Keys which did not get a frame of their own (drawn together with other keys).
+        std::size_t deferred{};  // Frames which had to wait because of the FPS cap.
+        std::size_t idle{};      // Steps which waited for a key with nothing to draw.
+        Duration lastFrame{};    // Draw time of the last frame.
+        Duration longestFrame{}; // The longest draw time.
+};
+
+/**
+ * Frame pacing and redraw coalescing. Keys are queued with post, poll applies all of them with
+ * one (batched) og::input and then draws (only if something is dirty) at most once per frame interval, so a
+ * burst of keys (autorepeat, a held button) costs a single frame. deadline tells when poll has
+ * to be called next, or that there is nothing to do until the next key. Clock is a std::chrono
+ * like clock (a fake one in tests).
+ */
+template <typename Display, detail::augment::window_wrapper Win, std::size_t queueSize = 16, typename Clock = std::chrono::steady_clock>
+class Scheduler {
+public:
+        using Duration = typename Clock::duration;
+        using TimePoint = typename Clock::time_point;
+        using Statistics = SchedulerStatistics<Duration>;
+
+        Scheduler (Display &disp, Win &win, unsigned int fps = 30) : display{disp}, window{win} { fpsCap (fps); }
+
+        /// Maximum number of frames per second. 0 means no cap.
+        void fpsCap (unsigned int fps)
+        {
+                interval = (fps == 0) ? Duration{} : Duration{std::chrono::duration_cast<Duration> (std::chrono::seconds{1}) / fps};
+        }
+
+        /// Queues a key. Returns false if the queue was full (the key is lost).
+        bool post (Key key);
+
+        /// Applies all the queued keys, then draws if something is dirty and the FPS cap allows. Returns true if drawn.
+        bool poll ();
+
+        /// When poll should be called next (now or in the past if a frame is due). Nothing if idle (wait for a key).
+        std::optional<TimePoint> deadline () const;
+
+        /**
+         * One iteration of a main loop. Waits for keys using waitKey until the deadline (forever if idle),
+         * then polls. waitKey (std::optional<Duration> timeout) has to return a std::optional<Key>, nothing
+         * on timeout, and must not block if timeout is zero.
+         */
+        template <typename WaitKey> bool step (WaitKey &&waitKey);
+
+        Statistics const &statistics () const { return statistics_; }
+
+private:
+        Display &display;
+        Win &window;
+        Duration interval{};
+        std::optional<TimePoint> lastFrame{};
+        std::array<Key, queueSize> queue{};
+        std::size_t head{};
+        std::size_t count{};
+        std::size_t eventsSinceFrame{};
+        bool deferring{};
+        Statistics statistics_{};
+};
+
+/*--------------------------------------------------------------------------*/
+
+template <typename Display, detail::augment::window_wrapper Win, std::size_t queueSize, typename Clock>
+bool Scheduler<Display, Win, queueSize, Clock>::post (Key key)
+{
+        if (count == queueSize) {
+                ++statistics_.dropped;
+                return false;
+        }
+
+        queue.at ((head + count) % queueSize) = key;
+        ++count;
+        return true;
+}
+
+/*--------------------------------------------------------------------------*/
+
+template <typename Display, detail::augment::window_wrapper Win, std::size_t queueSize, typename Clock>
+bool Scheduler<Display, Win, queueSize, Clock>::poll ()
+{
+        if (count > 0) { // One batch, so scroll is computed once.
+                std::array<Key, queueSize> keys{};
+
+                for (std::size_t i = 0; i < count; ++i) {
+                        keys.at (i) = queue.at ((head + i) % queueSize);
+                }
+
+                input (display, window, std::span<Key const> (keys.data (), count));
+                statistics_.events += count;
+                eventsSinceFrame += count;
+                head = (head + count) % queueSize;
+                count = 0;
+        }
+
+        if (!window.isDirty ()) {
+                return false;
+        }
+
+        auto const now = Clock::now ();
+
+        if (lastFrame && now < *lastFrame + interval) {
+                statistics_.deferred += int (!deferring);
+                deferring = true;
+                return false;
+        }
+
+        draw (display, window);
+        auto const drawTime = Clock::now () - now;
+
+        lastFrame = now;
+        deferring = false;
+        ++statistics_.frames;
+        statistics_.coalesced += (eventsSinceFrame > 1) ? eventsSinceFrame - 1 : 0;
+        statistics_.lastFrame = drawTime;
+        statistics_.longestFrame = std::max (statistics_.longestFrame, drawTime);
+        eventsSinceFrame = 0;
+        return true;
+}
+
+/*--------------------------------------------------------------------------*/
+
+template <typename Display, detail::augment::window_wrapper Win, std::size_t queueSize, typename Clock>
+auto Scheduler<Display, Win, queueSize, Clock>::deadline () const -> std::optional<TimePoint>
+{
+        if (count == 0 && !window.isDirty ()) {
+                return {};
+        }
+
+        if (count > 0 || !lastFrame) {
+                return Clock::now ();
+        }
+
+        return *lastFrame + interval;
+}
+
+/*--------------------------------------------------------------------------*/
+
+template <typename Display, detail::augment::window_wrapper Win, std::size_t queueSize, typename Clock>
+template <typename WaitKey>
+bool Scheduler<Display, Win, queueSize, Clock>::step (WaitKey &&waitKey)
+{
+        std::optional<Duration> timeout{};
+
+        if (auto when = deadline ()) {
+                timeout = std::max (Duration{}, *when - Clock::now ());
+        }
+        else {
+                ++statistics_.idle;
+        }
+
+        if (auto key = waitKey (timeout)) {
+                post (*key);
+
+                // Drain the burst (as much as fits).
+                while (count < queueSize) {
+                        if (auto next = waitKey (std::optional<Duration>{Duration{}})) {
+                                post (*next);
+                        }
+                        else {
+                                break;
+                        }
+                }
+        }
+
+        return poll ();
+}
+
+} // namespace og
@@ -8,58 +8,192 @@
 
 #pragma once
 #include "oledgui.h"
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
 #include <iostream>
+#include <unistd.h>
 
 namespace og {
 
 /**
- * Simplest dumb terminal backend.
+ * Simplest dumb (ANSI) terminal backend, meant for serial consoles and SSH sessions.
+ * The whole frame is assembled in a fixed size buffer and sent with a single write (2)
+ * call in refresh. Cursor position and text style sent to the terminal are tracked, so
+ * cursor-move and SGR sequences are emitted only when they would change something. If
+ * a frame does not fit into the buffer, it is sent in more than one write.
  */
-template <Dimension widthV, Dimension heightV, typename Child = Empty>
-class TerminalDisplay : public AbstractDisplay<TerminalDisplay<widthV, heightV, Child>, widthV, heightV, Child> {
+template <Dimension widthV, Dimension heightV> class TerminalDisplay : public AbstractDisplay<TerminalDisplay<widthV, heightV>, widthV, heightV> {
 public:
-        using Base = AbstractDisplay<TerminalDisplay<widthV, heightV, Child>, widthV, heightV, Child>;
+        using Base = AbstractDisplay<TerminalDisplay<widthV, heightV>, widthV, heightV>;
         using Base::cursor;
         using Base::width, Base::height;
 
-        void print (std::span<const char> const &str) override
-        {
-                std::cout << "\033[" << cursor ().y () + 1 << ";" << cursor ().x () + 1 << "H" << str.data () << std::flush;
+        /// Worst case for clear + every cell printed with its own cursor move and SGR.
+        static constexpr std::size_t capacity = heightV * (widthV + 16) + widthV * heightV * (4 + 16) + 16;
+
+        explicit TerminalDisplay (int fileDescriptor = STDOUT_FILENO) : fd{fileDescriptor} {}
+
+        void print (std::span<const char> const &str) final;
+        void clear () final;
+        void textStyle (style::Text stl) final { style_ = stl; }
+        void refresh () final;
+
+        /// Number of bytes sent by the last refresh.
+        std::size_t lastFrameSize () const { return lastFrameSize_; }
+
+private:
+        enum class Sgr : uint8_t { regular, highlighted, unknown };
+
+        void append (std::string_view str);
+        void append (Coordinate num);
+        void moveTo (Point const &pos);
+        void applyStyle ();
+        void send ();
+
+        std::array<char, capacity> frame{};
+        std::size_t frameSize{};
+        std::size_t sentBytes{};
+        std::size_t lastFrameSize_{};
+        int fd{};
+        style::Text style_{};
+        Sgr terminalStyle{Sgr::unknown};
+        Point terminalCursor{-1, -1}; // Unknown
+};
+
+/****************************************************************************/
+
+template <Dimension widthV, Dimension heightV> void TerminalDisplay<widthV, heightV>::print (std::span<const char> const &str)
+{
+        auto end = std::find (str.begin (), str.end (), '\0');
+
+        if (end == str.begin ()) {
+                return;
         }
 
-        void clear ()
-        {
-                cursor () = {0, 0};
-                textStyle (Style::regular);
+        moveTo (cursor ());
+        applyStyle ();
+        append (std::string_view (str.begin (), end));
+        terminalCursor.x () += Coordinate (std::count_if (str.begin (), end, [] (char chr) { return (uint8_t (chr) & 0xc0U) != 0x80U; }));
+}
 
-                for (int y = 0; y < heightV; ++y) {
-                        std::cout << "\033[" << y + 1 << ";0H" << std::flush;
-                        for (int x = 0; x < widthV; ++x) {
-                                std::cout.put (' ');
-                        }
+/****************************************************************************/
+
+template <Dimension widthV, Dimension heightV> void TerminalDisplay<widthV, heightV>::clear ()
+{
+        cursor () = {0, 0};
+        style_ = style::Text::regular;
+        applyStyle ();
+
+        constexpr std::string_view spaces{"                                "};
+
+        for (Coordinate y = 0; y < Coordinate (heightV); ++y) {
+                moveTo ({0, y});
+
+                for (Dimension rest = widthV; rest > 0;) {
+                        auto len = std::min<std::size_t> (rest, spaces.size ());
+                        append (spaces.substr (0, len));
+                        rest -= len;
                 }
+
+                terminalCursor.x () = widthV;
+        }
+}
+
+/****************************************************************************/
+
+template <Dimension widthV, Dimension heightV> void TerminalDisplay<widthV, heightV>::refresh ()
+{
+        append ("\033[0m");
+        terminalStyle = Sgr::unknown;
+        send ();
+        lastFrameSize_ = sentBytes;
+        sentBytes = 0;
+}
+
+/****************************************************************************/
+
+template <Dimension widthV, Dimension heightV> void TerminalDisplay<widthV, heightV>::moveTo (Point const &pos)
+{
+        if (pos.x () == terminalCursor.x () && pos.y () == terminalCursor.y ()) {
+                return;
         }
 
-        void textStyle (Style c)
-        {
-                if (c == Style::regular) {
-                        std::cout << "\033[44m" << std::flush;
+        append ("\033[");
+        append (Coordinate (pos.y () + 1));
+        append (";");
+        append (Coordinate (pos.x () + 1));
+        append ("H");
+        terminalCursor = pos;
+}
+
+/****************************************************************************/
+
+template <Dimension widthV, Dimension heightV> void TerminalDisplay<widthV, heightV>::applyStyle ()
+{
+        auto wanted = (style_ == style::Text::highlighted) ? Sgr::highlighted : Sgr::regular;
+
+        if (wanted == terminalStyle) {
+                return;
+        }
+
+        append ((wanted == Sgr::highlighted) ? "\033[34;47m" : "\033[37;44m");
+        terminalStyle = wanted;
+}
+
+/****************************************************************************/
+
+template <Dimension widthV, Dimension heightV> void TerminalDisplay<widthV, heightV>::append (std::string_view str)
+{
+        while (!str.empty ()) {
+                if (frameSize == frame.size ()) {
+                        send ();
                 }
-                else if (c == Style::highlighted) {
-                        std::cout << "\033[47m" << std::endl;
+
+                auto len = std::min (str.size (), frame.size () - frameSize);
+                std::copy_n (str.begin (), len, std::next (frame.begin (), frameSize));
+                frameSize += len;
+                str.remove_prefix (len);
+        }
+}
+
+template <Dimension widthV, Dimension heightV> void TerminalDisplay<widthV, heightV>::append (Coordinate num)
+{
+        std::array<char, 8> buf{};
+        auto [ptr, ec] = std::to_chars (buf.begin (), buf.end (), num);
+        append (std::string_view (buf.begin (), ptr));
+}
+
+/****************************************************************************/
+
+template <Dimension widthV, Dimension heightV> void TerminalDisplay<widthV, heightV>::send ()
+{
+        std::size_t sent{};
+
+        while (sent < frameSize) {
+                auto ret = ::write (fd, std::next (frame.data (), sent), frameSize - sent);
+
+                if (ret < 0) {
+                        if (errno == EINTR) {
+                                continue;
+                        }
+
+                        break; // Nothing sensible can be done. The frame is lost.
                 }
+
+                sent += ret;
         }
 
-        void refresh () { std::cout << "\033[0m" << std::flush; }
+        sentBytes += frameSize;
+        frameSize = 0;
+}
 
-private:
-        using Base::child;
-};
+/****************************************************************************/
 
-og::Key getKey (int ch)
+inline og::Key getKey (int chr)
 {
         // TODO characters must be customizable (compile time)
-        switch (ch) {
+        switch (chr) {
         case 's':
                 return Key::incrementFocus;
 
@@ -74,6 +208,6 @@ og::Key getKey (int ch)
         }
 }
 
-og::Key getKey () { return getKey (std::cin.get ()); }
+inline og::Key getKey () { return getKey (std::cin.get ()); }
 
 } // namespace og
@@ -7,17 +7,59 @@
  ****************************************************************************/
 
 #pragma once
+#include "framebuffer.h"
 #include "oledgui.h"
 #include <type_traits>
 #include <zephyr/display/cfb.h>
+#include <zephyr/drivers/display.h>
 #include <zephyr/sys/printk.h>
 
 // #define debugMacro printk
 
 namespace og::zephyr::cfb {
 
+/**
+ * Zephyr display device seen as a c::pageDevice. Every write sends one window of a single page.
+ */
+struct PageDevice {
+        void write (Coordinate x, Coordinate page, std::span<uint8_t const> columns) const
+        {
+                display_buffer_descriptor desc{};
+                desc.buf_size = columns.size ();
+                desc.width = columns.size ();
+                desc.height = 8;
+                desc.pitch = columns.size ();
+
+                if (int err = display_write (display, x, page * 8, &desc, columns.data ()); err != 0) {
+                        printk ("Could not write to the display (err %d)\n", err);
+                }
+        }
+
+        device const *display{};
+};
+
+/**
+ * Returns the font registered with FONT_ENTRY_DEFINE (the same index as in cfb_framebuffer_set_font).
+ */
+inline cfb_font const *getFont (int idx)
+{
+        int i{};
+
+        STRUCT_SECTION_FOREACH (cfb_font, font)
+        {
+                if (i++ == idx) {
+                        return font;
+                }
+        }
+
+        return nullptr;
+}
+
 /**
  * Zephyr backend
+ * Glyphs are taken from the cfb font, but the framebuffer is our own, because the one inside
+ * the cfb subsystem is not accessible, and cfb_framebuffer_finalize always sends the whole
+ * thing. Here only the page windows that changed since the last refresh are sent.
  * TODO make character width and height customizable (template param)
  * TODO optimize this "old-school" font because now there are 2 pixel vertical spaces between the glyphs.
  */
@@ -27,68 +69,102 @@ public:
         using Base::cursor;
         using Base::width, Base::height;
 
-        Display (device const *disp);
+        static constexpr Dimension glyphWidth = 7;
+        static constexpr Dimension glyphHeight = 8;
+
+        /// inverted : white background.
+        Display (device const *disp, bool inverted = false, int fontIdx = 0);
 
-        void print (std::span<const char> const &str) override
+        void print (std::span<const char> const &str) final
         {
-                // We do the copy to have null-terminated string suitable for C API.
-                std::array<char, widthV + 1> tmp;
-                auto n = std::min<size_t> (widthV, str.size ());
-                std::copy_n (str.begin (), n, tmp.begin ());
-                tmp.at (n) = '\0';
-
-                // TODO why data instead of c_str! Obviously this code expects null-trminated string!
-                // if (cfb_print (display, const_cast<char *> (static_cast<const char *> (str.data ())), cursor ().x () * 7, cursor ().y () * 8)
-                if (cfb_print (display, tmp.data (), cursor ().x () * 7, cursor ().y () * 8) != 0) {
-                        printk ("cfb_print is unable to print\r\n");
+                if (font == nullptr) {
+                        return;
                 }
 
-                if (style_ == style::Text::highlighted) {
-                        if (int err = cfb_invert_area (display, cursor ().x () * 7, cursor ().y () * 8, str.size () * 7, 8); err != 0) {
-                                printk ("Could not invert (err %d)\n", err);
+                uint8_t const mask = ((style_ == style::Text::highlighted) != inverted) ? 0xff : 0x00;
+                Coordinate x = cursor ().x () * glyphWidth;
+
+                for (char chr : str) {
+                        if ((static_cast<uint8_t> (chr) & 0xc0U) == 0x80U) {
+                                continue; // UTF-8 continuation byte. Multibyte characters are not in the font.
                         }
+
+                        if (chr == '\0' || x >= Coordinate (widthV * glyphWidth)) {
+                                break;
+                        }
+
+                        framebuffer.blit (x, cursor ().y (), glyph (chr), mask);
+                        x += glyphWidth;
                 }
         }
 
-        void clear () override
+        void clear () final
         {
-                // This clears the whole screen. Not desirable, multiple layers do not work.
-                if (int err = cfb_framebuffer_clear (display, false); err) {
-                        printk ("Could not clear framebuffer (err %d)\n", err);
-                }
-
+                framebuffer.clear (inverted ? 0xff : 0x00);
                 cursor ().x () = 0;
                 cursor ().y () = 0;
-                // printk ("clear\r\n");
         }
 
-        void textStyle (style::Text stl) override
-        {
-                style_ = stl;
-                // printk ("style %d,%d\r\n", cursor ().x () * 7, cursor ().y () * 8);
-        }
+        void textStyle (style::Text stl) final { style_ = stl; }
 
-        void refresh () override
-        {
-                if (int err = cfb_framebuffer_finalize (display); err) {
-                        printk ("Could not finalize framebuffer (err %d)\n", err);
-                }
-                // printk ("refresh\r\n");
-        }
+        void refresh () final { lastFlushBytes = framebuffer.flush (bus); }
+
+        /// How many bytes the last refresh has sent.
+        std::size_t flushedBytes () const { return lastFlushBytes; }
 
 private:
-        device const *display{};
+        std::span<uint8_t const> glyph (char chr);
+
+        PageDevice bus;
+        cfb_font const *font{};
+        PageFramebuffer<widthV * glyphWidth, heightV * glyphHeight> framebuffer;
+        std::array<uint8_t, glyphWidth> glyphBuffer{};
+        std::size_t lastFlushBytes{};
         style::Text style_{};
+        bool inverted{};
 };
 
 /****************************************************************************/
 
-template <Dimension widthV, Dimension heightV> Display<widthV, heightV>::Display (device const *disp) : display{disp}
+template <Dimension widthV, Dimension heightV>
+Display<widthV, heightV>::Display (device const *disp, bool inv, int fontIdx) : bus{disp}, font{getFont (fontIdx)}, inverted{inv}
 {
-        if (!device_is_ready (display)) {
+        if (!device_is_ready (bus.display)) {
                 printk ("Display device not ready\n");
                 return;
         }
+
+        if (font == nullptr || font->width != glyphWidth || font->height != glyphHeight
+            || (font->caps & CFB_FONT_MONO_VPACKED) == 0) {
+                printk ("Unsupported font. %dx%d vertically packed font is required\n", glyphWidth, glyphHeight);
+                font = nullptr;
+        }
+}
+
+/****************************************************************************/
+
+template <Dimension widthV, Dimension heightV> std::span<uint8_t const> Display<widthV, heightV>::glyph (char chr)
+{
+        auto uchr = static_cast<uint8_t> (chr);
+
+        if (uchr < font->first_char || uchr > font->last_char) {
+                uchr = ' ';
+        }
+
+        auto const *src = static_cast<uint8_t const *> (font->data) + (uchr - font->first_char) * glyphWidth;
+
+        if ((font->caps & CFB_FONT_MSB_FIRST) == 0) {
+                return {src, glyphWidth};
+        }
+
+        // Our pages have LSB on top.
+        std::transform (src, src + glyphWidth, glyphBuffer.begin (), [] (uint8_t col) {
+                col = ((col & 0xf0U) >> 4U) | ((col & 0x0fU) << 4U);
+                col = ((col & 0xccU) >> 2U) | ((col & 0x33U) << 2U);
+                return uint8_t (((col & 0xaaU) >> 1U) | ((col & 0x55U) << 1U));
+        });
+
+        return glyphBuffer;
 }
 
 /****************************************************************************/
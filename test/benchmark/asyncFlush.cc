@@ -0,0 +1,146 @@
+/****************************************************************************
+ *                                                                          *
+ *  Author : lukasz.iwaszkiewicz@gmail.com                                  *
+ *  ~~~~~~~~                                                                *
+ *  License : see COPYING file for details.                                 *
+ *  ~~~~~~~~~                                                               *
+ ****************************************************************************/
+
+/**
+ * Synchronous refresh compared with the double buffered FlushThread. Both render a 128x64
+ * PixelDisplay into a MockBus as slow as a 400 kHz I2C. Keys arrive at a fixed rate. The UI
+ * time is how long input + draw (including refresh) takes, so 1 / UI time is the frame rate
+ * the UI can sustain. Latency is the time from a key press until the frame showing its effect
+ * has left the bus (input to photon), including the time the key waited for the UI.
+ */
+#include "mockBus.h"
+#include "oledgui/flushThread.h"
+#include "oledgui/pixel.h"
+#include <algorithm>
+#include <iostream>
+#include <numeric>
+#include <vector>
+
+using namespace og;
+using namespace std::string_view_literals;
+using namespace std::chrono_literals;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+constexpr int KEYS = 200;
+constexpr auto KEY_INTERVAL = 1ms; // Faster than the bus can show the changes.
+using Bus = MockBus<128, 64>;
+
+struct Result {
+        Clock::duration uiTime{};
+        std::vector<Clock::duration> latencies;
+};
+
+auto makeWindow ()
+{
+        return window<0, 0, 21, 8> (vbox (check (false, " option 1"sv), check (false, " option 2"sv), check (false, " option 3"sv),
+                                         check (false, " option 4"sv), check (false, " option 5"sv), check (false, " option 6"sv),
+                                         check (false, " option 7"sv), check (false, " option 8"sv)));
+}
+
+Key keyFor (int i) { return (i % 2 == 0) ? Key::select : Key::incrementFocus; }
+
+/**
+ * Runs the key sequence. Returns the time the UI was busy, and the press time of every key. The
+ * first (full) frame is sent before the first key.
+ */
+template <typename Display, typename Wait, typename Callback>
+Clock::duration run (Display &display, std::vector<Clock::time_point> &pressed, Wait waitForBus, Callback afterDraw)
+{
+        auto win = makeWindow ();
+        draw (display, win);
+        waitForBus ();
+        Clock::duration busy{};
+        auto const start = Clock::now () + 10ms;
+
+        for (int i = 0; i < KEYS; ++i) {
+                pressed.at (i) = start + i * KEY_INTERVAL;
+                std::this_thread::sleep_until (pressed.at (i)); // No sleep if the UI is late (the key was queued).
+
+                auto const begin = Clock::now ();
+                input (display, win, keyFor (i));
+                draw (display, win);
+                busy += Clock::now () - begin;
+                afterDraw (i);
+        }
+
+        return busy;
+}
+
+Result synchronous ()
+{
+        Bus bus;
+        PixelDisplay<128, 64, font::Classic6x8, Bus> display{bus};
+        std::vector<Clock::time_point> pressed (KEYS);
+        Result result{.latencies = std::vector<Clock::duration> (KEYS)};
+
+        // refresh returns after the frame has been sent.
+        result.uiTime = run (
+                display, pressed, [] {}, [&] (int i) { result.latencies.at (i) = Clock::now () - pressed.at (i); });
+        return result;
+}
+
+Result asynchronous ()
+{
+        Bus bus;
+        FlushThread<128, 64, Bus> flushThread{bus};
+        PixelDisplay<128, 64, font::Classic6x8, FlushThread<128, 64, Bus>> display{flushThread};
+        std::vector<Clock::time_point> pressed (KEYS);
+        std::vector<std::size_t> sequence (KEYS);
+        std::vector<Clock::time_point> sent (KEYS + 2);
+        Result result{.latencies = std::vector<Clock::duration> (KEYS)};
+
+        // Records when every frame has left the bus.
+        std::jthread monitor{[&flushThread, &sent] (std::stop_token const &stop) {
+                std::size_t recorded{};
+
+                while (!stop.stop_requested ()) {
+                        auto completed = std::min (flushThread.buffer ().completed (), sent.size () - 1);
+
+                        for (auto now = Clock::now (); recorded < completed;) {
+                                sent.at (++recorded) = now;
+                        }
+
+                        std::this_thread::sleep_for (50us);
+                }
+        }};
+
+        result.uiTime = run (
+                display, pressed, [&flushThread] { flushThread.wait (); }, [&] (int i) { sequence.at (i) = flushThread.buffer ().committed (); });
+        flushThread.wait ();
+        std::this_thread::sleep_for (1ms);
+        monitor.request_stop ();
+        monitor.join ();
+
+        for (int i = 0; i < KEYS; ++i) {
+                result.latencies.at (i) = sent.at (sequence.at (i)) - pressed.at (i);
+        }
+
+        return result;
+}
+
+void report (char const *name, Result const &result)
+{
+        using Ms = std::chrono::duration<double, std::milli>;
+        auto total = std::accumulate (result.latencies.cbegin (), result.latencies.cend (), Clock::duration{});
+        auto max = *std::max_element (result.latencies.cbegin (), result.latencies.cend ());
+
+        std::cout << name << " : UI time " << Ms (result.uiTime / KEYS).count () << " ms/frame ("
+                  << KEYS / std::chrono::duration<double> (result.uiTime).count () << " frames/s), latency mean "
+                  << Ms (total / KEYS).count () << " ms, max " << Ms (max).count () << " ms" << std::endl;
+}
+
+} // namespace
+
+int main ()
+{
+        report ("synchronous ", synchronous ());
+        report ("asynchronous", asynchronous ());
+        return 0;
+}
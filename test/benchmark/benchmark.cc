@@ -7,16 +7,25 @@
  ****************************************************************************/
 
 /**
- * All functionalities in one place. Manual regression testing
+ * All functionalities in one place. Rendered into the headless CharGridDisplay, so only
+ * the cost of the library itself is measured.
  */
 // #include "oledgui/debug.h"
-#include "oledgui/ncurses.h"
+#include "oledgui/charGrid.h"
 
 using namespace og;
 using namespace std::string_view_literals;
 
 enum class Windows { menu, allFeatures, dialog, textBox };
 
+using Display = CharGridDisplay<18, 7>;
+
+#ifdef STATIC_DISPATCH
+using DrawDisplay = Display; // Windows and the suite are bound to the concrete display, no virtual calls.
+#else
+using DrawDisplay = IDisplay;
+#endif
+
 /****************************************************************************/
 
 struct ShowFrame {
@@ -28,7 +37,7 @@ struct ShowFrame {
 int main ()
 {
 
-        NcursesDisplay<18, 7> d1;
+        Display d1;
 
         ISuite<Windows> *mySuiteP{};
 
@@ -36,7 +45,7 @@ int main ()
 
         auto backButton = button ([&mySuiteP] { mySuiteP->current () = Windows::menu; }, "[back]"sv);
 
-        auto allFeatures = window<0, 0, 18, 7> (
+        auto allFeatures = window<DrawDisplay, 0, 0, 18, 7> (
                 vbox (std::ref (backButton),                                                                                                 //
                       hbox (label ("Hello "sv), check (true, " 1 "sv), check (false, " 2 "sv)),                                              //
                       hbox (label ("World "sv), check (false, " 5 "sv), check (true, " 6 "sv)),                                              //
@@ -76,7 +85,7 @@ int main ()
                        hbox (button ([&mySuiteP] { mySuiteP->current () = Windows::allFeatures; }, "[OK]"sv), button ([] {}, "[Cl]"sv)),
                        check (false, "15 "sv));
 
-        auto dialog = window<4, 1, 10, 5, ShowFrame> (std::ref (v));
+        auto dialog = window<DrawDisplay, 4, 1, 10, 5, ShowFrame> (std::ref (v));
         // log (dialog);
 
         /*--------------------------------------------------------------------------*/
@@ -97,15 +106,15 @@ the first element of the sequence at position zero.)"};
         auto dwn = button ([&txt, &startLine] { startLine = txt.setStartLine (++startLine); }, "▼"sv);
         auto txtComp = hbox (std::ref (txt), vbox<1> (std::ref (up), vspace<4>, std::ref (dwn)));
 
-        auto textReferences = window<0, 0, 18, 7> (vbox (std::ref (backButton), std::ref (txtComp)));
+        auto textReferences = window<DrawDisplay, 0, 0, 18, 7> (vbox (std::ref (backButton), std::ref (txtComp)));
 
         /*--------------------------------------------------------------------------*/
 
-        auto menu = window<0, 0, 18, 7> (vbox (label ("----Main menu-----"sv),
+        auto menu = window<DrawDisplay, 0, 0, 18, 7> (vbox (label ("----Main menu-----"sv),
                                                button ([&mySuiteP] { mySuiteP->current () = Windows::allFeatures; }, "input API  "sv),
                                                button ([&mySuiteP] { mySuiteP->current () = Windows::textBox; }, "text widget"sv)));
 
-        auto mySuite = suite<Windows> (element (Windows::menu, std::ref (menu)),               //
+        auto mySuite = suite<Windows, DrawDisplay> (element (Windows::menu, std::ref (menu)),               //
                                        element (Windows::allFeatures, std::ref (allFeatures)), //
                                        element (Windows::dialog, std::ref (allFeatures), std::ref (dialog)),
                                        element (Windows::textBox, std::ref (textReferences)) //
@@ -0,0 +1,51 @@
+/****************************************************************************
+ *                                                                          *
+ *  Author : lukasz.iwaszkiewicz@gmail.com                                  *
+ *  ~~~~~~~~                                                                *
+ *  License : see COPYING file for details.                                 *
+ *  ~~~~~~~~~                                                               *
+ ****************************************************************************/
+
+/**
+ * Cost of a focus change (including scrollToFocus) in a window with a 500 item vbox.
+ * Nothing is drawn, only og::input is measured.
+ */
+#include "oledgui/charGrid.h"
+#include <chrono>
+#include <iostream>
+#include <utility>
+
+using namespace og;
+using namespace std::string_view_literals;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+constexpr std::size_t ITEMS = 500;
+constexpr int ROUNDS = 20;
+
+template <std::size_t... i> auto makeWindow (std::index_sequence<i...> /* seq */)
+{
+        return window<0, 0, 18, 7> (vbox ((void (i), check (false, " item"sv))...));
+}
+
+} // namespace
+
+int main ()
+{
+        CharGridDisplay<18, 7> display;
+        auto win = makeWindow (std::make_index_sequence<ITEMS>{});
+        draw (display, win);
+
+        auto const begin = Clock::now ();
+
+        for (int r = 0; r < ROUNDS; ++r) {
+                for (std::size_t i = 0; i < ITEMS; ++i) {
+                        input (display, win, (r % 2 == 0) ? Key::incrementFocus : Key::decrementFocus);
+                }
+        }
+
+        auto const elapsed = std::chrono::duration<double, std::nano> (Clock::now () - begin);
+        std::cout << "focus change in a " << ITEMS << " item vbox : " << elapsed.count () / (ROUNDS * ITEMS) << " ns" << std::endl;
+        return 0;
+}
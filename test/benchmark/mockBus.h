@@ -0,0 +1,35 @@
+/****************************************************************************
+ *                                                                          *
+ *  Author : lukasz.iwaszkiewicz@gmail.com                                  *
+ *  ~~~~~~~~                                                                *
+ *  License : see COPYING file for details.                                 *
+ *  ~~~~~~~~~                                                               *
+ ****************************************************************************/
+
+#pragma once
+#include "oledgui/framebuffer.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+/**
+ * Page device simulating a slow bus. Every write blocks for the transaction overhead plus the
+ * time per byte. The defaults match a 400 kHz I2C SSD1306 (9 clocks per byte, address and
+ * command bytes for every window).
+ */
+template <og::Dimension widthPx, og::Dimension heightPx> struct MockBus {
+        using Duration = std::chrono::nanoseconds;
+        static constexpr og::Dimension pages = heightPx / 8;
+
+        void write (og::Coordinate x, og::Coordinate page, std::span<uint8_t const> columns)
+        {
+                std::this_thread::sleep_for (perTransaction + perByte * columns.size ());
+                std::copy (columns.begin (), columns.end (), std::next (ram.begin (), page * widthPx + x));
+                bytes += columns.size ();
+        }
+
+        Duration perByte{22500};
+        Duration perTransaction{200000};
+        std::array<uint8_t, widthPx * pages> ram{};
+        std::atomic<std::size_t> bytes{};
+};
@@ -0,0 +1,134 @@
+/****************************************************************************
+ *                                                                          *
+ *  Author : lukasz.iwaszkiewicz@gmail.com                                  *
+ *  ~~~~~~~~                                                                *
+ *  License : see COPYING file for details.                                 *
+ *  ~~~~~~~~~                                                               *
+ ****************************************************************************/
+
+/**
+ * Frames per second of the NcursesDisplay compared with its previous implementation
+ * (one std::string per print, mvwprintw, wclear and wrefresh every frame). Run it in
+ * a terminal, results are printed after both runs end.
+ */
+#include "oledgui/ncurses.h"
+#include <chrono>
+#include <iostream>
+
+using namespace og;
+using namespace std::string_view_literals;
+
+namespace {
+
+/**
+ * Previous implementation, kept here for comparison.
+ */
+template <Dimension widthV, Dimension heightV>
+class LegacyNcursesDisplay : public AbstractDisplay<LegacyNcursesDisplay<widthV, heightV>, widthV, heightV> {
+public:
+        using Base = AbstractDisplay<LegacyNcursesDisplay<widthV, heightV>, widthV, heightV>;
+        using Base::cursor;
+        using Base::width, Base::height;
+
+        LegacyNcursesDisplay ()
+        {
+                setlocale (LC_ALL, "");
+                initscr ();
+                curs_set (0);
+                noecho ();
+                cbreak ();
+                use_default_colors ();
+                start_color ();
+                init_pair (1, COLOR_WHITE, COLOR_BLUE);
+                init_pair (2, COLOR_BLUE, COLOR_WHITE);
+                keypad (stdscr, true);
+                win = newwin (height (), width (), 0, 0);
+                wbkgd (win, COLOR_PAIR (1));
+                refresh ();
+        }
+
+        LegacyNcursesDisplay (LegacyNcursesDisplay const &) = delete;
+        LegacyNcursesDisplay &operator= (LegacyNcursesDisplay const &) = delete;
+        LegacyNcursesDisplay (LegacyNcursesDisplay &&) noexcept = delete;
+        LegacyNcursesDisplay &operator= (LegacyNcursesDisplay &&) noexcept = delete;
+        ~LegacyNcursesDisplay () noexcept override
+        {
+                clrtoeol ();
+                refresh ();
+                endwin ();
+        }
+
+        void print (std::span<const char> const &str) override
+        {
+                std::string tmp{str.begin (), str.end ()};
+                mvwprintw (win, cursor ().y (), cursor ().x (), tmp.data ());
+        }
+
+        void clear () override
+        {
+                wclear (win);
+                cursor ().x () = 0;
+                cursor ().y () = 0;
+        }
+
+        void textStyle (style::Text clr) override
+        {
+                if (clr == style::Text::highlighted) {
+                        wattron (win, COLOR_PAIR (2));
+                }
+                else {
+                        wattron (win, COLOR_PAIR (1));
+                }
+        }
+
+        void refresh () override
+        {
+                ::refresh ();
+                wrefresh (win);
+        }
+
+private:
+        WINDOW *win{};
+};
+
+constexpr int FRAMES = 2000;
+
+template <typename Display> double framesPerSecond ()
+{
+        Display d1;
+        int value{};
+
+        auto win = window<0, 0, 18, 7> (vbox (hbox (label ("Hello "sv), check (true, " 1 "sv), check (false, " 2 "sv)),     //
+                                              hbox (label ("World "sv), check (false, " 5 "sv), check (true, " 6 "sv)),     //
+                                              line<18>,                                                                     //
+                                              group ([] (auto o) {}, radio (0, " R "sv), radio (1, " G "sv), radio (2, " B "sv)), //
+                                              hbox (label ("Value: "sv), number<0, 9> (std::ref (value))),                  //
+                                              combo ([] (auto o) {}, option (0, "red"sv), option (1, "green"sv)),           //
+                                              check (false, " 7 "sv),                                                       //
+                                              check (false, " 8 "sv),                                                       //
+                                              check (false, " 9 "sv)));
+
+        auto start = std::chrono::steady_clock::now ();
+
+        for (int i = 0; i < FRAMES; ++i) {
+                draw (d1, win);
+                input (d1, win, Key::incrementFocus);
+                value = i % 10;
+        }
+
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now () - start;
+        return FRAMES / elapsed.count ();
+}
+
+} // namespace
+
+int main ()
+{
+        double legacy = framesPerSecond<LegacyNcursesDisplay<18, 7>> ();
+        double current = framesPerSecond<NcursesDisplay<18, 7>> ();
+
+        std::cout << "legacy  : " << legacy << " frames/s" << std::endl;
+        std::cout << "current : " << current << " frames/s" << std::endl;
+        std::cout << "speedup : " << current / legacy << std::endl;
+        return 0;
+}
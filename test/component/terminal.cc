@@ -8,6 +8,10 @@
 
 #include "oledgui/terminal.h"
 
+struct ShowFrame {
+        static constexpr bool frame = true;
+};
+
 // int test1 ()
 // {
 //         using namespace og;
@@ -148,7 +152,7 @@ int test2 ()
                        hbox (button ([&showDialog] { showDialog = false; }, "[OK]"sv), button ([] {}, "[Cl]"sv)),
                        check ([] (bool) {}, " 15 "sv));
 
-        auto dialog = window<4, 1, 10, 5, true> (std::ref (v));
+        auto dialog = window<4, 1, 10, 5, ShowFrame> (std::ref (v));
 
         // log (dialog);
 
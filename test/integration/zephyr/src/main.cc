@@ -9,6 +9,7 @@
 #include "cfb_font_oldschool.h"
 #include "key.h"
 #include <cstddef>
+#include <oledgui/eventQueue.h>
 #include <oledgui/zephyrCfb.h>
 #include <optional>
 #include <string_view>
@@ -21,7 +22,8 @@
 #include <zephyr/zephyr.h>
 
 LOG_MODULE_REGISTER (main);
-K_SEM_DEFINE (userInput, 0, 1);
+K_SEM_DEFINE (userInput, 0, K_SEM_MAX_LIMIT); // Counts the events in keyEvents.
+og::EventQueue<og::KeyEvent, 16> keyEvents;
 
 const struct device *display;
 
@@ -68,16 +70,27 @@ void init ()
         //         cfb_get_display_parameter (dev, CFB_DISPLAY_HEIGH), ppt, rows, cfb_get_display_parameter (dev, CFB_DISPLAY_COLS));
 
         cfb_framebuffer_set_font (display, 0);
-        cfb_framebuffer_invert (display);
 }
 
-og::Key currentKey{og::Key::unknown};
+/**
+ * Called from the key callbacks. Every press is queued, so two presses close together are not lost.
+ * The callbacks run from k_timer expiry functions (the system clock ISR), so there is one producer.
+ */
+void postKey (og::Key key, og::Press press = og::Press::normal)
+{
+        if (keyEvents.push ({key, press, k_uptime_get_32 ()})) {
+                k_sem_give (&userInput);
+        }
+}
+
 og::Key getKey ()
 {
-        if (k_sem_take (&userInput, K_FOREVER) == 0) {
-                auto tmp = currentKey;
-                currentKey = og::Key::unknown;
-                return tmp;
+        while (true) {
+                k_sem_take (&userInput, K_FOREVER);
+
+                if (auto event = keyEvents.pop (); event && event->press == og::Press::normal) {
+                        return event->key;
+                }
         }
 }
 
@@ -91,35 +104,41 @@ int main ()
                 GPIO_DT_SPEC_GET (DT_PATH (ui_buttons, button_up), gpios),
                 [] {
                         LOG_INF ("decrementFocus event");
-                        currentKey = og::Key::decrementFocus;
-                        k_sem_give (&userInput);
+                        postKey (og::Key::decrementFocus);
                 },
-                [] { LOG_INF ("df long"); });
+                [] {
+                        LOG_INF ("df long");
+                        postKey (og::Key::decrementFocus, og::Press::longPress);
+                });
 
         zephyr::Key downKey (
                 GPIO_DT_SPEC_GET (DT_PATH (ui_buttons, button_down), gpios),
                 [] {
                         LOG_INF ("incrementFocus event");
-                        currentKey = og::Key::incrementFocus;
-                        k_sem_give (&userInput);
+                        postKey (og::Key::incrementFocus);
                 },
-                [] { LOG_INF ("if long"); });
+                [] {
+                        LOG_INF ("if long");
+                        postKey (og::Key::incrementFocus, og::Press::longPress);
+                });
 
         zephyr::Key enterKey (
                 GPIO_DT_SPEC_GET (DT_PATH (ui_buttons, button_enter), gpios),
                 [] {
                         LOG_INF ("select event");
-                        currentKey = og::Key::select;
-                        k_sem_give (&userInput);
+                        postKey (og::Key::select);
                 },
-                [] { LOG_INF ("en long"); });
+                [] {
+                        LOG_INF ("en long");
+                        postKey (og::Key::select, og::Press::longPress);
+                });
 
         /*--------------------------------------------------------------------------*/
 
         using namespace og;
         using namespace std::string_view_literals;
 
-        og::zephyr::cfb::Display<18, 7> d1 (display);
+        og::zephyr::cfb::Display<18, 7> d1 (display, true); // Inverted (white background)
 
         bool showDialog{};
 
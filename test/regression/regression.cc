@@ -16,6 +16,7 @@
 #include "number.h"
 #include "oledgui/debug.h"
 #include "oledgui/ncurses.h"
+#include "oledgui/scheduler.h"
 #include "progress.h"
 #include "styles.h"
 #include "textWidget.h"
@@ -54,9 +55,10 @@ int main ()
 
         // auto status = window<0, 0, 18, 1> (hbox (label ("----Main menu-----"sv)));
 
+        Scheduler scheduler{d1, mySuite};
+
         while (true) {
-                draw (d1, /* status, */ mySuite);
-                input (d1, mySuite, getKey ());
+                scheduler.step ([] (auto delay) { return waitKey (delay); });
         }
 
         return 0;
@@ -0,0 +1,99 @@
+/****************************************************************************
+ *                                                                          *
+ *  Author : lukasz.iwaszkiewicz@gmail.com                                  *
+ *  ~~~~~~~~                                                                *
+ *  License : see COPYING file for details.                                 *
+ *  ~~~~~~~~~                                                               *
+ ****************************************************************************/
+
+#include "oledgui/charGrid.h"
+#include <array>
+#include <catch2/catch.hpp>
+#include <string_view>
+#include <vector>
+
+using namespace og;
+using namespace std::string_view_literals;
+
+namespace {
+
+auto makeWindow (std::array<bool, 8> &values)
+{
+        auto clb = [&values] (std::size_t i) { return [&values, i] (bool checked) { values.at (i) = checked; }; };
+
+        return window<0, 0, 6, 3> (vbox (check (clb (0), " 0"sv), check (clb (1), " 1"sv), check (clb (2), " 2"sv), check (clb (3), " 3"sv),
+                                         check (clb (4), " 4"sv), check (clb (5), " 5"sv), check (clb (6), " 6"sv), check (clb (7), " 7"sv)));
+}
+
+template <typename Display> std::vector<std::string> rows (Display const &display)
+{
+        std::vector<std::string> ret;
+        std::array<char, 64> buffer{};
+
+        for (Coordinate y = 0; y < 3; ++y) {
+                ret.emplace_back (display.row (y, buffer));
+        }
+
+        return ret;
+}
+
+} // namespace
+
+TEST_CASE ("Batched input", "[input]")
+{
+        std::array<bool, 8> one{};
+        std::array<bool, 8> batch{};
+        auto winOne = makeWindow (one);
+        auto winBatch = makeWindow (batch);
+        CharGridDisplay<6, 3> displayOne;
+        CharGridDisplay<6, 3> displayBatch;
+        draw (displayOne, winOne);
+        draw (displayBatch, winBatch);
+
+        // Scroll is compared only if requested, it may differ if the focus goes back and forth (see Window::input).
+        auto check = [&] (std::span<Key const> keys, bool sameScroll = true) {
+                for (Key key : keys) {
+                        input (displayOne, winOne, key);
+                }
+
+                input (displayBatch, winBatch, keys);
+                REQUIRE (winBatch.isDirty ());
+                draw (displayOne, winOne);
+                draw (displayBatch, winBatch);
+                REQUIRE (one == batch);
+
+                if (sameScroll) {
+                        REQUIRE (rows (displayOne) == rows (displayBatch));
+                }
+        };
+
+        SECTION ("Focus moves with selects in between")
+        {
+                check (std::array{Key::select, Key::incrementFocus, Key::incrementFocus, Key::select, Key::incrementFocus,
+                                  Key::incrementFocus, Key::incrementFocus, Key::select});
+                REQUIRE (batch == std::array{true, false, true, false, false, true, false, false});
+        }
+
+        SECTION ("Wrap around both ways")
+        {
+                check (std::array{Key::decrementFocus, Key::select, Key::decrementFocus, Key::select}, false);
+                REQUIRE (batch.at (7));
+                REQUIRE (batch.at (6));
+                REQUIRE (rows (displayOne) == std::vector<std::string>{". 5   ", "x 6   ", "x 7   "});
+                REQUIRE (rows (displayBatch) == std::vector<std::string>{". 4   ", ". 5   ", "x 6   "}); // Scrolled straight to 6.
+
+                check (std::array<Key, 11>{Key::incrementFocus, Key::incrementFocus, Key::incrementFocus, Key::incrementFocus,
+                                           Key::incrementFocus, Key::incrementFocus, Key::incrementFocus, Key::incrementFocus,
+                                           Key::incrementFocus, Key::incrementFocus, Key::select});
+                REQUIRE (batch.at (0));
+        }
+
+        SECTION ("Nothing to do")
+        {
+                std::array<bool, 8> values{};
+                auto win = makeWindow (values);
+                draw (displayBatch, win);
+                input (displayBatch, win, std::array{Key::incrementFocus, Key::decrementFocus});
+                REQUIRE (!win.isDirty ());
+        }
+}
@@ -0,0 +1,188 @@
+/****************************************************************************
+ *                                                                          *
+ *  Author : lukasz.iwaszkiewicz@gmail.com                                  *
+ *  ~~~~~~~~                                                                *
+ *  License : see COPYING file for details.                                 *
+ *  ~~~~~~~~~                                                               *
+ ****************************************************************************/
+
+#include "oledgui/buffered.h"
+#include <catch2/catch.hpp>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace og;
+using namespace std::string_view_literals;
+
+namespace {
+
+/// Records everything that was printed.
+struct RecordingDisplay : public AbstractDisplay<RecordingDisplay, 18, 7> {
+        void print (std::span<const char> const &str) final { prints.emplace_back (str.begin (), str.end ()); }
+        void clear () final { ++clears; }
+        void textStyle (style::Text stl) final { styles.push_back (stl); }
+        void refresh () final { ++refreshes; }
+
+        std::vector<std::string> prints;
+        std::vector<style::Text> styles;
+        int clears{};
+        int refreshes{};
+};
+
+struct ShowFrame {
+        static constexpr bool frame = true;
+};
+
+} // namespace
+
+TEST_CASE ("Char grid", "[display]")
+{
+        detail::CharGrid<4, 2> grid;
+
+        grid.write ({1, 0}, "▲ab"sv, style::Text::highlighted);
+        CHECK (std::string_view{grid.at (1, 0).glyph.data (), grid.at (1, 0).size ()} == "▲"sv);
+        CHECK (grid.at (2, 0).glyph.front () == 'a');
+        CHECK (grid.at (3, 0).glyph.front () == 'b');
+        CHECK (grid.at (3, 0).style == style::Text::highlighted);
+        CHECK (grid.at (0, 0) == detail::Cell{});
+
+        SECTION ("Clipping")
+        {
+                grid.write ({-1, 1}, "xyz"sv, style::Text::regular);
+                CHECK (grid.at (0, 1).glyph.front () == 'y');
+                grid.write ({0, 2}, "xyz"sv, style::Text::regular); // Ignored
+                grid.write ({3, 1}, "12"sv, style::Text::regular);
+                CHECK (grid.at (3, 1).glyph.front () == '1');
+        }
+}
+
+TEST_CASE ("Buffered display sends only changed cells", "[display]")
+{
+        RecordingDisplay backend;
+        BufferedDisplay<18, 7, RecordingDisplay> display{backend};
+        int value{};
+
+        auto win = window<0, 0, 18, 7> (vbox (label ("Hello"sv), hbox (label ("Value: "sv), number<0, 9> (std::ref (value)))));
+
+        draw (display, win);
+        CHECK (backend.clears == 1);
+        CHECK (backend.refreshes == 1);
+        CHECK (display.cellsSent () == 12); // "Hello" + "Value:" + "0", blanks are skipped.
+
+        draw (display, win);
+        CHECK (backend.clears == 1);
+        CHECK (display.cellsSent () == 0);
+
+        value = 7;
+        backend.prints.clear ();
+        draw (display, win);
+        CHECK (display.cellsSent () == 1);
+        REQUIRE (backend.prints.size () == 1);
+        CHECK (backend.prints.front () == "7");
+        CHECK (backend.cursor ().x () == 7);
+        CHECK (backend.cursor ().y () == 1);
+        CHECK (display.totalCellsSent () == 13);
+}
+
+TEST_CASE ("Char grid display", "[display]")
+{
+        CharGridDisplay<8, 2> display;
+        auto win = window<0, 0, 8, 2> (vbox (label ("Hi ▲"sv), check (false, " a"sv)));
+        std::array<char, 32> buf{};
+
+        draw (display, win);
+        CHECK (display.refreshes () == 1);
+        CHECK (display.row (0, buf) == "Hi ▲    "sv);
+        CHECK (display.row (1, buf) == ". a     "sv);
+        CHECK (display.grid ().at (0, 1).style == style::Text::highlighted);
+        CHECK (display.row (0, std::span{buf}.first (4)) == "Hi "sv); // "▲" does not fit.
+
+        auto first = display.hash ();
+        draw (display, win);
+        CHECK (display.hash () == first);
+
+        input (display, win, Key::select);
+        draw (display, win);
+        CHECK (display.row (1, buf) == "x a     "sv);
+        CHECK (display.hash () != first);
+}
+
+TEST_CASE ("Static dispatch", "[display]")
+{
+        using Display = CharGridDisplay<8, 2>;
+        Display dynamic;
+        Display bound;
+
+        auto make = [] { return vbox (label ("Hi"sv), check (false, " a"sv), check (false, " b"sv)); };
+        auto win = window<0, 0, 8, 2> (make ());
+        auto staticWin = window<Display, 0, 0, 8, 2> (make ());
+        static_assert (std::is_base_of_v<detail::augment::IWindow, decltype (win)>);
+        static_assert (!std::is_base_of_v<detail::augment::IWindow, decltype (staticWin)>);
+
+        for (Key key : {Key::incrementFocus, Key::select, Key::unknown}) {
+                input (dynamic, win, key);
+                input (bound, staticWin, key);
+                draw (dynamic, win);
+                draw (bound, staticWin);
+                CHECK (dynamic.hash () == bound.hash ());
+        }
+
+        CHECK (bound.grid ().at (0, 1).glyph.front () == 'x');
+}
+
+TEST_CASE ("Clipping to the window", "[display]")
+{
+        RecordingDisplay display;
+
+        SECTION ("Long label")
+        {
+                auto win = window<2, 1, 4, 2> (vbox (label ("abcdefgh"sv), label ("▲▼▲▼▲"sv), label ("hidden"sv)));
+                draw (display, win);
+                REQUIRE (display.prints.size () == 2);
+                CHECK (display.prints.at (0) == "abcd");
+                CHECK (display.prints.at (1) == "▲▼▲▼");
+                CHECK (display.clippedCharacters () == 4 + 1);
+                CHECK (display.viewport ().area.dimensions.width == 18); // Restored after the window.
+        }
+
+        SECTION ("Frame")
+        {
+                auto win = window<0, 0, 5, 3, ShowFrame> (vbox (label ("abcdef"sv)));
+                draw (display, win);
+                CHECK (std::find (display.prints.cbegin (), display.prints.cend (), "abc") != display.prints.cend ());
+                CHECK (display.clippedCharacters () == 3);
+        }
+
+        SECTION ("Display edge")
+        {
+                detail::print (display, "left"sv);
+                display.cursor () = {16, 0};
+                detail::print (display, "right"sv);
+                display.cursor () = {-2, 0};
+                detail::print (display, "left"sv);
+                display.cursor () = {0, 7};
+                detail::print (display, "below"sv);
+
+                REQUIRE (display.prints.size () == 3);
+                CHECK (display.prints.at (1) == "ri");
+                CHECK (display.prints.at (2) == "ft");
+                CHECK (display.cursor ().x () == 0);
+                CHECK (display.clippedCharacters () == 3 + 2 + 5);
+        }
+}
+
+TEST_CASE ("Multibyte labels", "[display]")
+{
+        CharGridDisplay<8, 3> display;
+        std::array<char, 32> buf{};
+        int value{};
+
+        auto win = window<0, 0, 8, 3> (vbox (hbox (label ("▲"sv), button ([] {}, "…"sv), check (true, "▼"sv)),
+                                             hbox (group (std::ref (value), radio (0, "▲"sv), radio (1, "▼"sv)), label ("|"sv)),
+                                             hbox (combo (std::ref (value), option (0, "…"sv), option (1, "b"sv)), label ("|"sv))));
+        draw (display, win);
+        CHECK (display.row (0, buf) == "▲…x▼    "sv);
+        CHECK (display.row (1, buf) == "o▲.▼|   "sv);
+        CHECK (display.row (2, buf) == "…|      "sv);
+}
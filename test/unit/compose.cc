@@ -0,0 +1,151 @@
+/****************************************************************************
+ *                                                                          *
+ *  Author : lukasz.iwaszkiewicz@gmail.com                                  *
+ *  ~~~~~~~~                                                                *
+ *  License : see COPYING file for details.                                 *
+ *  ~~~~~~~~~                                                               *
+ ****************************************************************************/
+
+#include "oledgui/charGrid.h"
+#include <catch2/catch.hpp>
+#include <string>
+#include <string_view>
+
+using namespace og;
+using namespace std::string_view_literals;
+
+namespace {
+
+/// Renders into a CharGrid and counts the printed characters per row.
+struct RecordingDisplay : public AbstractDisplay<RecordingDisplay, 10, 4> {
+
+        void print (std::span<const char> const &str) final
+        {
+                auto len = std::distance (str.begin (), std::find (str.begin (), str.end (), '\0'));
+                grid.write (cursor (), str, style);
+                printed.at (cursor ().y ()) += len;
+        }
+
+        void clear () final
+        {
+                grid.clear ();
+                cursor () = {0, 0};
+        }
+
+        void textStyle (style::Text stl) final { style = stl; }
+        void refresh () final { ++refreshes; }
+
+        std::string row (Coordinate y) const
+        {
+                std::string ret;
+
+                for (auto const &cell : grid.row (y)) {
+                        ret.append (cell.glyph.data (), cell.size ());
+                }
+
+                return ret;
+        }
+
+        detail::CharGrid<10, 4> grid;
+        std::array<int, 4> printed{};
+        style::Text style{};
+        int refreshes{};
+};
+
+} // namespace
+
+TEST_CASE ("Occlusion helpers", "[compose]")
+{
+        std::array<Rect, 2> const areas{Rect{{2, 1}, {3, 2}}, Rect{{5, 1}, {2, 1}}};
+
+        CHECK (detail::skipCovered (areas, {0, 1}) == 0);
+        CHECK (detail::skipCovered (areas, {2, 1}) == 7); // Adjacent areas
+        CHECK (detail::skipCovered (areas, {2, 2}) == 5);
+        CHECK (detail::skipCovered (areas, {2, 0}) == 2);
+        CHECK (detail::skipUncovered (areas, {0, 1}, 10) == 2);
+        CHECK (detail::skipUncovered (areas, {0, 1}, 1) == 1);
+        CHECK (detail::skipUncovered (areas, {7, 1}, 10) == 10);
+}
+
+TEST_CASE ("Compose stacked windows", "[compose]")
+{
+        RecordingDisplay display;
+
+        auto desktop = window<0, 0, 10, 4> (vbox (label ("0123456789"sv), label ("abcdefghij"sv), check (true, " desk"sv), label ("ABCDEFGHIJ"sv)));
+        auto dialog = window<2, 1, 5, 2> (vbox (check (false, " 1"sv), check (false, " 2"sv)));
+
+        REQUIRE (compose (display, desktop, dialog));
+        CHECK (display.row (0) == "0123456789");
+        CHECK (display.row (1) == "ab. 1  hij");
+        CHECK (display.row (2) == "x . 2     ");
+        CHECK (display.row (3) == "ABCDEFGHIJ");
+        CHECK (display.refreshes == 1);
+
+        SECTION ("Nothing changed")
+        {
+                CHECK (!compose (display, desktop, dialog));
+                CHECK (display.refreshes == 1);
+        }
+
+        SECTION ("Only the dialog is redrawn")
+        {
+                display.printed = {};
+                input (display, dialog, Key::select);
+                REQUIRE (compose (display, desktop, dialog));
+                CHECK (display.row (1) == "abx 1  hij");
+                CHECK (display.printed.at (0) == 0);
+                CHECK (display.printed.at (3) == 0);
+                CHECK (display.printed.at (1) == 5 + 3); // Cleared dialog area and the check.
+        }
+
+        SECTION ("The dialog is redrawn over the desktop")
+        {
+                input (display, desktop, Key::select);
+                REQUIRE (compose (display, desktop, dialog));
+                CHECK (display.row (1) == "ab. 1  hij");
+                CHECK (display.row (2) == ". . 2     ");
+        }
+}
+
+TEST_CASE ("Compose a suite", "[compose]")
+{
+        enum class Windows { desktop, dialog };
+        RecordingDisplay display;
+
+        auto desktop = window<0, 0, 10, 4> (vbox (label ("0123456789"sv), label ("abcdefghij"sv)));
+        auto dialog = window<2, 1, 5, 1> (vbox (check (false, " 1"sv)));
+        auto mySuite = suite<Windows> (element (Windows::desktop, std::ref (desktop)), element (Windows::dialog, std::ref (desktop), std::ref (dialog)));
+
+        REQUIRE (compose (display, mySuite));
+        CHECK (display.row (1) == "abcdefghij");
+        CHECK (!compose (display, mySuite));
+
+        mySuite.current () = Windows::dialog;
+        REQUIRE (compose (display, mySuite));
+        CHECK (display.row (1) == "ab. 1  hij");
+
+        display.printed = {};
+        input (display, mySuite, Key::select);
+        REQUIRE (compose (display, mySuite));
+        CHECK (display.row (1) == "abx 1  hij");
+        CHECK (display.printed.at (0) == 0);
+}
+
+TEST_CASE ("Covered widgets are skipped", "[compose]")
+{
+        RecordingDisplay display;
+        int value{};
+
+        auto desktop = window<0, 0, 10, 4> (vbox (label ("0123456789"sv), hbox (label ("ab"sv), number<0, 9> (std::ref (value))), label ("ABCDEFGHIJ"sv)));
+        auto bar = window<0, 1, 10, 1> (vbox (label ("bar"sv)));
+
+        REQUIRE (compose (display, desktop, bar));
+        CHECK (display.row (1) == "bar       ");
+        CHECK (display.printed.at (1) == 10 + 3); // Only the bar : cleared and printed.
+
+        value = 5; // Desktop is dirty, but the row with the number is not visible.
+        display.printed = {};
+        REQUIRE (compose (display, desktop, bar));
+        CHECK (display.row (1) == "bar       ");
+        CHECK (display.printed.at (1) == 10 + 3);
+}
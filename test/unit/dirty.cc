@@ -0,0 +1,95 @@
+/****************************************************************************
+ *                                                                          *
+ *  Author : lukasz.iwaszkiewicz@gmail.com                                  *
+ *  ~~~~~~~~                                                                *
+ *  License : see COPYING file for details.                                 *
+ *  ~~~~~~~~~                                                               *
+ ****************************************************************************/
+
+#include "oledgui/charGrid.h"
+#include "oledgui/extra.h"
+#include <catch2/catch.hpp>
+#include <string_view>
+
+using namespace og;
+using namespace std::string_view_literals;
+
+TEST_CASE ("Dirty tracking", "[dirty]")
+{
+        CharGridDisplay<10, 4> display;
+        int value{};
+        int percent{};
+        int color{};
+
+        auto win = window<0, 0, 10, 4> (vbox (hbox (label ("N "sv), number<0, 9> (std::ref (value))),            //
+                                              group (std::ref (color), radio (0, "R"sv), radio (1, "G"sv)), //
+                                              progress<10, 0, 100> (std::ref (percent))));
+
+        CHECK (win.isDirty ()); // Never drawn
+        CHECK (drawIfDirty (display, win));
+        CHECK (!win.isDirty ());
+        CHECK (!drawIfDirty (display, win));
+        CHECK (display.refreshes () == 1);
+
+        SECTION ("Focus")
+        {
+                input (display, win, Key::incrementFocus);
+                CHECK (win.isDirty ());
+                CHECK (drawIfDirty (display, win));
+        }
+
+        SECTION ("Input which changes nothing")
+        {
+                input (display, win, Key::unknown);
+                CHECK (!win.isDirty ());
+        }
+
+        SECTION ("Values changed via std::ref")
+        {
+                value = 3;
+                CHECK (win.isDirty ());
+                draw (display, win);
+
+                percent = 50;
+                CHECK (win.isDirty ());
+                draw (display, win);
+
+                color = 1;
+                CHECK (win.isDirty ());
+                draw (display, win);
+                CHECK (!win.isDirty ());
+        }
+
+        SECTION ("Select")
+        {
+                input (display, win, Key::select);
+                CHECK (value == 1);
+                CHECK (win.isDirty ());
+        }
+
+        SECTION ("Invalidate")
+        {
+                win.invalidate ();
+                CHECK (drawIfDirty (display, win));
+        }
+}
+
+TEST_CASE ("Dirty tracking in a suite", "[dirty]")
+{
+        enum class Windows { first, second };
+        CharGridDisplay<10, 1> display;
+
+        auto first = window<0, 0, 10, 1> (vbox (check (false, " 1"sv)));
+        auto second = window<0, 0, 10, 1> (vbox (check (false, " 2"sv)));
+        auto mySuite = suite<Windows> (element (Windows::first, std::ref (first)), element (Windows::second, std::ref (second)));
+
+        CHECK (drawIfDirty (display, mySuite));
+        CHECK (!drawIfDirty (display, mySuite));
+
+        mySuite.current () = Windows::second;
+        CHECK (drawIfDirty (display, mySuite));
+        CHECK (!mySuite.isDirty ());
+
+        input (display, mySuite, Key::select);
+        CHECK (drawIfDirty (display, mySuite));
+}
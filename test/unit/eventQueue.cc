@@ -0,0 +1,117 @@
+/****************************************************************************
+ *                                                                          *
+ *  Author : lukasz.iwaszkiewicz@gmail.com                                  *
+ *  ~~~~~~~~                                                                *
+ *  License : see COPYING file for details.                                 *
+ *  ~~~~~~~~~                                                               *
+ ****************************************************************************/
+
+#include "oledgui/eventQueue.h"
+#include <catch2/catch.hpp>
+#include <thread>
+
+using namespace og;
+
+TEST_CASE ("Event queue", "[eventQueue]")
+{
+        EventQueue<KeyEvent, 4> queue;
+        REQUIRE (queue.empty ());
+        REQUIRE (!queue.pop ());
+
+        for (uint32_t i = 0; i < 4; ++i) {
+                REQUIRE (queue.push ({Key::select, Press::normal, i}));
+        }
+
+        REQUIRE (queue.size () == 4);
+        REQUIRE (!queue.push ({Key::incrementFocus, Press::longPress, 4})); // Full.
+        REQUIRE (queue.overruns () == 1);
+
+        REQUIRE (queue.pop ()->timestamp == 0);
+        REQUIRE (queue.push ({Key::incrementFocus, Press::longPress, 5})); // Wraps around.
+
+        for (uint32_t i = 1; i < 4; ++i) {
+                REQUIRE (queue.pop ()->timestamp == i);
+        }
+
+        auto last = queue.pop ();
+        REQUIRE (last);
+        REQUIRE (last->key == Key::incrementFocus);
+        REQUIRE (last->press == Press::longPress);
+        REQUIRE (last->timestamp == 5);
+        REQUIRE (queue.empty ());
+}
+
+/**
+ * A producer thread injects events as fast as it can (retrying when the queue is full, like
+ * a driver with its own backlog would), while the consumer pops them. Every event must come
+ * out exactly once and in order. Also with the producer not retrying: the events which were
+ * accepted must all arrive, and the rest must be counted as overruns.
+ */
+TEST_CASE ("Event queue stress", "[eventQueue]")
+{
+        constexpr uint32_t EVENTS = 200'000;
+        EventQueue<KeyEvent, 16> queue;
+
+        SECTION ("Retrying producer")
+        {
+                std::jthread producer{[&queue] {
+                        for (uint32_t i = 0; i < EVENTS; ++i) {
+                                while (!queue.push ({Key (i % 4), Press (i % 2), i})) {
+                                        std::this_thread::yield ();
+                                }
+                        }
+                }};
+
+                uint32_t expected{};
+                uint32_t errors{};
+
+                while (expected < EVENTS) {
+                        if (auto event = queue.pop ()) {
+                                errors += uint32_t (event->timestamp != expected || event->key != Key (expected % 4)
+                                                    || event->press != Press (expected % 2));
+                                ++expected;
+                        }
+                        else {
+                                std::this_thread::yield ();
+                        }
+                }
+
+                producer.join ();
+                REQUIRE (errors == 0);
+                REQUIRE (queue.empty ());
+        }
+
+        SECTION ("Overruns")
+        {
+                std::atomic<uint32_t> accepted{};
+                std::atomic<bool> done{};
+
+                std::jthread producer{[&] {
+                        for (uint32_t i = 0; i < EVENTS; ++i) {
+                                accepted += uint32_t (queue.push ({Key::select, Press::normal, i}));
+                        }
+
+                        done = true;
+                }};
+
+                uint32_t received{};
+                uint32_t outOfOrder{};
+                std::optional<uint32_t> previous;
+
+                while (!done || !queue.empty ()) {
+                        if (auto event = queue.pop ()) {
+                                outOfOrder += uint32_t (previous && event->timestamp <= *previous);
+                                previous = event->timestamp;
+                                ++received;
+                        }
+                        else {
+                                std::this_thread::yield ();
+                        }
+                }
+
+                producer.join ();
+                REQUIRE (outOfOrder == 0);
+                REQUIRE (received == accepted);
+                REQUIRE (accepted + queue.overruns () == EVENTS);
+        }
+}
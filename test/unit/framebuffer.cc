@@ -0,0 +1,158 @@
+/****************************************************************************
+ *                                                                          *
+ *  Author : lukasz.iwaszkiewicz@gmail.com                                  *
+ *  ~~~~~~~~                                                                *
+ *  License : see COPYING file for details.                                 *
+ *  ~~~~~~~~~                                                               *
+ ****************************************************************************/
+
+#include "mockDevice.h"
+#include "oledgui/doubleBuffer.h"
+#include "oledgui/flushThread.h"
+#include "oledgui/framebuffer.h"
+#include "oledgui/pixel.h"
+#include <catch2/catch.hpp>
+#include <sstream>
+
+using namespace og;
+
+namespace {
+constexpr std::array<uint8_t, 7> glyphA{0x7e, 0x11, 0x11, 0x11, 0x7e, 0x00, 0x00};
+constexpr std::array<uint8_t, 7> glyphB{0x7f, 0x49, 0x49, 0x49, 0x36, 0x00, 0x00};
+
+/// Simulates og::draw : clear and repaint 18x7 characters of 7x8 pixels.
+template <typename Fb> void repaint (Fb &fb, Coordinate changedX = -1)
+{
+        fb.clear ();
+
+        for (Coordinate page = 0; page < 7; ++page) {
+                for (Coordinate x = 0; x < 18; ++x) {
+                        fb.blit (x * 7, page, (x == changedX && page == 3) ? glyphB : glyphA);
+                }
+        }
+}
+} // namespace
+
+TEST_CASE ("Page framebuffer flushes only changed windows", "[framebuffer]")
+{
+        PageFramebuffer<126, 56> fb;
+        MockDevice<126, 56> dev;
+
+        repaint (fb);
+        CHECK (fb.flush (dev) == 126 * 7); // First flush sends everything
+        CHECK (dev.writes == 7);
+
+        dev = {.ram = dev.ram};
+        repaint (fb);
+        CHECK (fb.flush (dev) == 0); // Touched, but nothing has changed.
+        CHECK (dev.writes == 0);
+
+        repaint (fb, 5);
+        CHECK (fb.flush (dev) == 5); // Only the differing columns of a single glyph
+        CHECK (dev.writes == 1);
+        CHECK (std::equal (dev.ram.cbegin (), dev.ram.cend (), fb.data ().begin ()));
+
+        SECTION ("Invert and clipping")
+        {
+                dev = {.ram = dev.ram};
+                fb.invert (120, 0, 10);
+                CHECK (fb.flush (dev) == 6);
+                CHECK (fb.column (125, 0) == 0xff);
+
+                fb.blit (-3, 1, glyphB, 0xff);
+                CHECK (fb.column (0, 1) == uint8_t (~0x49));
+                CHECK (fb.flush (dev) == 4);
+                CHECK (std::equal (dev.ram.cbegin (), dev.ram.cend (), fb.data ().begin ()));
+        }
+
+        SECTION ("Invalidate")
+        {
+                fb.invalidate ();
+                CHECK (fb.flush (dev) == 126 * 7);
+        }
+}
+
+TEST_CASE ("Pixel display", "[framebuffer]")
+{
+        using namespace std::string_view_literals;
+        MockDevice<36, 16> dev;
+        PixelDisplay<36, 16, font::Classic6x8, MockDevice<36, 16>> display{dev};
+        static_assert (display.width () == 6 && display.height () == 2);
+
+        auto win = window<0, 0, 6, 2> (vbox (label ("Hi"sv), check (true, " ▲"sv)));
+        draw (display, win);
+
+        auto const &fb = display.framebuffer ();
+        CHECK (fb.column (0, 0) == 0x7f);             // 'H'
+        CHECK (fb.column (5, 0) == 0x00);             // Spacing
+        CHECK (fb.column (0, 1) == uint8_t (~0x44));  // Focused 'x' is inverted
+        CHECK (fb.column (12, 1) == uint8_t (~0x40)); // '▲'
+        CHECK (display.flushedBytes () == 36 * 2);
+        CHECK (std::equal (dev.ram.cbegin (), dev.ram.cend (), fb.data ().begin ()));
+
+        std::ostringstream out;
+        fb.dump (out);
+        CHECK (out.str ().substr (0, 37) == "#...#...#...........................\n"sv);
+
+        draw (display, win);
+        CHECK (display.flushedBytes () == 0);
+}
+
+TEST_CASE ("Double buffer", "[framebuffer]")
+{
+        PageFramebuffer<126, 56> fb;
+        DoubleBuffer<126, 56> buffer;
+        MockDevice<126, 56> dev;
+
+        auto sendAll = [&buffer, &dev] {
+                while (auto transfer = buffer.next ()) {
+                        dev.write (transfer->x, transfer->page, transfer->columns);
+                }
+        };
+
+        CHECK (!buffer.next ()); // Nothing to do.
+
+        repaint (fb);
+        fb.flush (buffer);
+        CHECK (buffer.commit ()); // Idle, has to be woken up.
+        CHECK (buffer.committed () == 1);
+
+        // The UI goes on while the first frame is being sent.
+        auto first = buffer.next ();
+        REQUIRE (first);
+        CHECK (first->page == 0);
+        CHECK (first->columns.size () == 126);
+
+        repaint (fb, 5);
+        fb.flush (buffer);
+        CHECK (!buffer.commit ()); // Busy.
+        repaint (fb, 6);
+        fb.flush (buffer);
+        CHECK (!buffer.commit ()); // Merged with the previous one.
+        CHECK (buffer.completed () == 0);
+
+        dev.write (first->x, first->page, first->columns);
+        sendAll ();
+        CHECK (buffer.completed () == 3);
+        CHECK (dev.writes == 7 + 1); // The first frame and the merged one.
+        CHECK (std::equal (dev.ram.cbegin (), dev.ram.cend (), fb.data ().begin ()));
+}
+
+TEST_CASE ("Flush thread", "[framebuffer]")
+{
+        using namespace std::string_view_literals;
+        MockDevice<36, 16> dev;
+        FlushThread<36, 16, MockDevice<36, 16>> flushThread{dev};
+        PixelDisplay<36, 16, font::Classic6x8, FlushThread<36, 16, MockDevice<36, 16>>> display{flushThread};
+
+        auto win = window<0, 0, 6, 2> (vbox (check (false, " a"sv), check (false, " b"sv)));
+
+        for (auto key : {Key::select, Key::incrementFocus, Key::select, Key::decrementFocus}) {
+                input (display, win, key);
+                draw (display, win);
+        }
+
+        flushThread.wait ();
+        CHECK (flushThread.buffer ().completed () == 4);
+        CHECK (std::equal (dev.ram.cbegin (), dev.ram.cend (), display.framebuffer ().data ().begin ()));
+}
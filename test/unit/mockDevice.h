@@ -0,0 +1,29 @@
+/****************************************************************************
+ *                                                                          *
+ *  Author : lukasz.iwaszkiewicz@gmail.com                                  *
+ *  ~~~~~~~~                                                                *
+ *  License : see COPYING file for details.                                 *
+ *  ~~~~~~~~~                                                               *
+ ****************************************************************************/
+
+#pragma once
+#include "oledgui/framebuffer.h"
+
+/**
+ * Page oriented display device which does nothing but counts bytes and keeps a copy
+ * of its (simulated) GDDRAM so the contents can be compared with the framebuffer.
+ */
+template <og::Dimension widthPx, og::Dimension heightPx> struct MockDevice {
+        static constexpr og::Dimension pages = heightPx / 8;
+
+        void write (og::Coordinate x, og::Coordinate page, std::span<uint8_t const> columns)
+        {
+                std::copy (columns.begin (), columns.end (), std::next (ram.begin (), page * widthPx + x));
+                bytes += columns.size ();
+                ++writes;
+        }
+
+        std::array<uint8_t, widthPx * pages> ram{};
+        std::size_t bytes{};
+        std::size_t writes{};
+};
@@ -0,0 +1,113 @@
+/****************************************************************************
+ *                                                                          *
+ *  Author : lukasz.iwaszkiewicz@gmail.com                                  *
+ *  ~~~~~~~~                                                                *
+ *  License : see COPYING file for details.                                 *
+ *  ~~~~~~~~~                                                               *
+ ****************************************************************************/
+
+#include "oledgui/charGrid.h"
+#include "oledgui/scheduler.h"
+#include <catch2/catch.hpp>
+#include <deque>
+#include <string_view>
+
+using namespace og;
+using namespace std::string_view_literals;
+using namespace std::chrono_literals;
+
+namespace {
+
+/// Time moves only when told to.
+struct FakeClock {
+        using duration = std::chrono::milliseconds;
+        using rep = duration::rep;
+        using period = duration::period;
+        using time_point = std::chrono::time_point<FakeClock>;
+        static constexpr bool is_steady = true;
+
+        static time_point now () { return current; }
+        static inline time_point current{};
+};
+
+} // namespace
+
+TEST_CASE ("Scheduler", "[scheduler]")
+{
+        CharGridDisplay<8, 3> display;
+        auto win = window<0, 0, 8, 3> (vbox (check (false, " a"sv), check (false, " b"sv), check (false, " c"sv)));
+        Scheduler<CharGridDisplay<8, 3>, decltype (win), 4, FakeClock> scheduler{display, win, 10}; // 100 ms per frame
+        FakeClock::current = {};
+
+        REQUIRE (scheduler.deadline () == FakeClock::now ()); // Never drawn.
+        CHECK (scheduler.poll ());
+        CHECK (!scheduler.deadline ()); // Idle
+        CHECK (!scheduler.poll ());
+
+        SECTION ("Burst of keys costs a single frame")
+        {
+                FakeClock::current += 100ms;
+
+                for (auto key : {Key::select, Key::incrementFocus, Key::select}) {
+                        CHECK (scheduler.post (key));
+                }
+
+                CHECK (scheduler.poll ());
+                CHECK (display.refreshes () == 2);
+                CHECK (scheduler.statistics ().events == 3);
+                CHECK (scheduler.statistics ().coalesced == 2);
+                CHECK (scheduler.statistics ().frames == 2);
+        }
+
+        SECTION ("FPS cap")
+        {
+                FakeClock::current += 30ms;
+                scheduler.post (Key::select);
+                CHECK (!scheduler.poll ()); // Too early, the key is applied though.
+                CHECK (win.isDirty ());
+                CHECK (scheduler.deadline () == FakeClock::time_point{100ms});
+                CHECK (scheduler.statistics ().deferred == 1);
+
+                FakeClock::current = FakeClock::time_point{100ms};
+                CHECK (scheduler.poll ());
+                CHECK (!scheduler.deadline ());
+
+                scheduler.fpsCap (0);
+                scheduler.post (Key::select);
+                CHECK (scheduler.poll ());
+        }
+
+        SECTION ("Full queue")
+        {
+                for (int i = 0; i < 5; ++i) {
+                        scheduler.post (Key::incrementFocus);
+                }
+
+                CHECK (scheduler.statistics ().dropped == 1);
+        }
+
+        SECTION ("Step")
+        {
+                std::deque<Key> keys{Key::select, Key::incrementFocus, Key::select};
+                std::vector<std::optional<FakeClock::duration>> timeouts;
+
+                auto waitKey = [&keys, &timeouts] (std::optional<FakeClock::duration> timeout) -> std::optional<Key> {
+                        timeouts.push_back (timeout);
+
+                        if (keys.empty ()) {
+                                return {};
+                        }
+
+                        auto key = keys.front ();
+                        keys.pop_front ();
+                        return key;
+                };
+
+                FakeClock::current += 100ms;
+                CHECK (scheduler.step (waitKey));
+                CHECK (timeouts.front () == std::nullopt); // Idle, waits forever.
+                CHECK (scheduler.statistics ().idle == 1);
+                CHECK (scheduler.statistics ().events == 3);
+                CHECK (scheduler.statistics ().frames == 2);
+        }
+}
@@ -0,0 +1,45 @@
+/****************************************************************************
+ *                                                                          *
+ *  Author : lukasz.iwaszkiewicz@gmail.com                                  *
+ *  ~~~~~~~~                                                                *
+ *  License : see COPYING file for details.                                 *
+ *  ~~~~~~~~~                                                               *
+ ****************************************************************************/
+
+#include "oledgui/terminal.h"
+#include <catch2/catch.hpp>
+#include <string>
+#include <string_view>
+
+using namespace og;
+using namespace std::string_view_literals;
+
+TEST_CASE ("Terminal display sends one frame with a single write", "[display]")
+{
+        std::array<int, 2> fds{};
+        REQUIRE (pipe (fds.data ()) == 0);
+
+        auto readAll = [&fds] {
+                std::string ret (4096, '\0');
+                auto len = read (fds[0], ret.data (), ret.size ());
+                ret.resize (std::max<ssize_t> (len, 0));
+                return ret;
+        };
+
+        TerminalDisplay<6, 2> d1{fds[1]};
+        auto win = window<0, 0, 6, 2> (vbox (label ("Hi"sv), check (true, " a"sv)));
+
+        draw (d1, win);
+        std::string frame = readAll ();
+        CHECK (frame.size () == d1.lastFrameSize ());
+        CHECK (frame
+               == "\033[37;44m\033[1;1H      \033[2;1H      " // clear
+                  "\033[1;1HHi"                               // label, the style is already set
+                  "\033[2;1H\033[34;47mx a\033[0m"sv);       // focused check, no cursor move before its label
+
+        draw (d1, win);
+        CHECK (readAll () == frame);
+
+        close (fds[0]);
+        close (fds[1]);
+}
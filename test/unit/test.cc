@@ -9,6 +9,7 @@
 #include "oledgui/oledgui.h"
 #include <array>
 #include <catch2/catch.hpp>
+#include <string>
 #include <string_view>
 
 using namespace og;
@@ -168,6 +169,33 @@ TEST_CASE ("Numeric to string conversion", "[detail]")
         // r.operator()<int> (d, c);
 }
 
+TEST_CASE ("Display width", "[detail]")
+{
+        using namespace std::string_view_literals;
+
+        CHECK (detail::displayWidth (""sv) == 0);
+        CHECK (detail::displayWidth ("▲"sv) == 1);
+        CHECK (detail::displayWidth ("🕨 …"sv) == 3);
+        CHECK (detail::displayWidth ("abc\0def"sv) == 3);
+
+        // Longer than a single 8 byte word, with a multibyte character crossing the word boundary.
+        CHECK (detail::displayWidth ("1234567▼89▲abcdefgh…"sv) == 20);
+
+        std::string str{"▲▼"};
+        detail::DisplayWidthCache<std::string> dynamic{str};
+        CHECK (dynamic (str) == 2);
+        str = "▲▲▲"; // Same size, measured every time.
+        CHECK (dynamic (str) == 3);
+
+        std::string_view view{"▲ "};
+        detail::DisplayWidthCache<std::string_view> cached{view};
+        CHECK (cached (view) == 2);
+        view = "…x";
+        CHECK (cached (view) == 2);
+        view = "…xy";
+        CHECK (cached (view) == 3);
+}
+
 static_assert (og::detail::IntStrLen<uint8_t>::value == 4);   // 255'\0'
 static_assert (og::detail::IntStrLen<int8_t>::value == 5);    // -128'\0'
 static_assert (og::detail::IntStrLen<uint16_t>::value == 6);  // 65536'\0'